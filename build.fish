@@ -83,6 +83,12 @@ if test "$platform" = "native"
         exit 1
     end
     
+    echo "🧩 Packing texture atlas..."
+    xmake build the-impale-atlas; and xmake run the-impale-atlas
+    if test $status -ne 0
+        echo "⚠️  Atlas packing failed, images will load one by one"
+    end
+
     echo "🔨 Building native target..."
     xmake build the-impale-game
     
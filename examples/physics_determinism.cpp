@@ -0,0 +1,177 @@
+/**
+ * Physics determinism check: 1 vs N Box2D workers
+ *
+ * Builds the same scene (ground, a box pile, pendulum chains) in worlds
+ * stepped with different JobSystem sizes and compares every body transform
+ * bit for bit after each second of simulation. Exits with 0 when all runs
+ * match the single-threaded one and every multi-worker run spread its
+ * Box2D tasks (solver stages included) over more than one job slot, 1
+ * otherwise. No window is opened.
+ *
+ * Compile with:
+ * g++ physics_determinism.cpp ../src/core/job_system.cpp -I../src -std=c++17 -pthread -lbox2d -lraylib -o physics_determinism
+ *
+ * Run:
+ * ./physics_determinism [workers...]   (default: 1 2 4 and all hardware threads)
+ */
+
+#include "box2d/box2d.h"
+#include "raylib.h"
+#include "../src/includes/core/job_system.hpp"
+#include "../src/includes/core/physics_tasks.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    constexpr float kUnitsPerMeter = 20.0f; // same scale as the game
+    constexpr float kTimeStep = 1.0f / 60.0f;
+    constexpr int kSubSteps = 4;
+    constexpr int kSeconds = 10;
+
+    void BuildScene(b2WorldId world, std::vector<b2BodyId> &bodies)
+    {
+        b2BodyDef groundDef = b2DefaultBodyDef();
+        groundDef.position = {48.0f, 52.0f};
+        b2BodyId ground = b2CreateBody(world, &groundDef);
+        b2Polygon groundBox = b2MakeBox(50.0f, 1.0f);
+        b2ShapeDef groundShape = b2DefaultShapeDef();
+        b2CreatePolygonShape(ground, &groundShape, &groundBox);
+
+        // Box pile: enough contacts to split over every worker
+        b2Polygon box = b2MakeBox(0.8f, 0.8f);
+        b2ShapeDef boxShape = b2DefaultShapeDef();
+        boxShape.density = 1.0f;
+        boxShape.material.friction = 0.6f;
+        for (int row = 0; row < 30; ++row)
+        {
+            for (int col = 0; col < 40; ++col)
+            {
+                b2BodyDef def = b2DefaultBodyDef();
+                def.type = b2_dynamicBody;
+                def.position = {10.0f + col * 1.9f + (row % 2) * 0.5f, 48.0f - row * 1.7f};
+                b2BodyId body = b2CreateBody(world, &def);
+                b2CreatePolygonShape(body, &boxShape, &box);
+                bodies.push_back(body);
+            }
+        }
+
+        // Pendulum chains (revolute joints, like impaled boxes on spikes)
+        b2Polygon link = b2MakeBox(0.2f, 0.6f);
+        for (int c = 0; c < 8; ++c)
+        {
+            b2BodyDef anchorDef = b2DefaultBodyDef();
+            anchorDef.position = {8.0f + c * 10.0f, -20.0f};
+            b2BodyId prev = b2CreateBody(world, &anchorDef);
+            for (int i = 0; i < 12; ++i)
+            {
+                b2BodyDef def = b2DefaultBodyDef();
+                def.type = b2_dynamicBody;
+                def.position = {8.0f + c * 10.0f + (i + 1) * 1.2f, -20.0f};
+                b2BodyId body = b2CreateBody(world, &def);
+                b2CreatePolygonShape(body, &boxShape, &link);
+
+                b2RevoluteJointDef joint = b2DefaultRevoluteJointDef();
+                joint.bodyIdA = prev;
+                joint.bodyIdB = body;
+                joint.localAnchorA = {i == 0 ? 0.0f : 0.6f, 0.0f};
+                joint.localAnchorB = {-0.6f, 0.0f};
+                b2CreateRevoluteJoint(world, &joint);
+
+                bodies.push_back(body);
+                prev = body;
+            }
+        }
+    }
+
+    struct Run
+    {
+        unsigned workers;
+        std::vector<std::vector<b2Transform>> snapshots; // one per simulated second
+        unsigned activeSlots{0};                         // job slots that ran Box2D tasks
+    };
+
+    Run Simulate(unsigned workers)
+    {
+        JobSystem jobs{workers};
+        PhysicsTasks tasks{jobs};
+
+        b2WorldDef def = b2DefaultWorldDef();
+        def.gravity.y = 1.8f * kUnitsPerMeter;
+        tasks.configure(def);
+        b2WorldId world = b2CreateWorld(&def);
+
+        std::vector<b2BodyId> bodies;
+        BuildScene(world, bodies);
+
+        Run run{workers, {}};
+        jobs.resetStats();
+        for (int second = 0; second < kSeconds; ++second)
+        {
+            for (int step = 0; step < 60; ++step)
+                b2World_Step(world, kTimeStep, kSubSteps);
+
+            std::vector<b2Transform> snapshot;
+            snapshot.reserve(bodies.size());
+            for (b2BodyId body : bodies)
+                snapshot.push_back(b2Body_GetTransform(body));
+            run.snapshots.push_back(std::move(snapshot));
+        }
+
+        for (const JobSystem::SlotStats &slot : jobs.stats())
+            run.activeSlots += slot.jobs > 0 ? 1u : 0u;
+
+        b2DestroyWorld(world);
+        return run;
+    }
+
+    // First second at which the runs differ, or -1
+    int FirstMismatch(const Run &a, const Run &b)
+    {
+        for (std::size_t s = 0; s < a.snapshots.size(); ++s)
+        {
+            const auto &x = a.snapshots[s];
+            const auto &y = b.snapshots[s];
+            if (x.size() != y.size() || std::memcmp(x.data(), y.data(), x.size() * sizeof(b2Transform)) != 0)
+                return static_cast<int>(s);
+        }
+        return -1;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    SetTraceLogLevel(LOG_WARNING);
+    b2SetLengthUnitsPerMeter(kUnitsPerMeter);
+
+    // Worker counts include the calling thread: N workers = N - 1 job threads
+    std::vector<unsigned> counts;
+    for (int i = 1; i < argc; ++i)
+        counts.push_back(static_cast<unsigned>(std::strtoul(argv[i], nullptr, 10)));
+    if (counts.empty())
+        counts = {1, 2, 4, JobSystem::DefaultWorkerCount() + 1};
+
+    Run reference = Simulate(0);
+    std::printf("reference: 1 worker, %zu bodies, %d s\n", reference.snapshots.back().size(), kSeconds);
+
+    bool identical = true;
+    for (unsigned count : counts)
+    {
+        if (count <= 1)
+            continue;
+        Run run = Simulate(count - 1);
+        int mismatch = FirstMismatch(reference, run);
+        if (mismatch < 0)
+            std::printf("%2u workers: identical, tasks ran on %u slots\n", count, run.activeSlots);
+        else
+            std::printf("%2u workers: DIFFERS after %d s\n", count, mismatch + 1);
+        if (run.activeSlots < 2)
+            std::printf("%2u workers: tasks never left one slot, the solver ran single-threaded\n", count);
+        identical = identical && mismatch < 0 && run.activeSlots >= 2;
+    }
+
+    return identical ? 0 : 1;
+}
@@ -0,0 +1,159 @@
+/**
+ * Settled pile benchmark: per-tick logic cost once every body is asleep
+ *
+ * Builds 5000 boxes (or the count given on the command line) in short stacks
+ * on a ground strip, with a row of spikes above them, and runs the game's
+ * per-tick systems (StepPhysics, UpdateCapture, UpdateScripts, UpdateLifetime,
+ * command buffer flush) at 60 Hz until Box2D reports no moving body. It then
+ * keeps ticking and compares the average cost of the logic around the Box2D
+ * step (pose cache, spatial grid, capture, scripts, lifetime) while the boxes
+ * are falling with the cost once they are settled. Exits with 1 if the pile
+ * never settles. No window is opened.
+ *
+ * Compile with:
+ * g++ -O2 settled_pile_benchmark.cpp ../src/core/command_buffer.cpp ../src/core/job_system.cpp ../src/core/spatial_grid.cpp -I../src -std=c++17 -pthread -lbox2d -lraylib -o settled_pile_benchmark
+ *
+ * Run:
+ * ./settled_pile_benchmark [boxes]
+ */
+
+#include "box2d/box2d.h"
+#include "raylib.h"
+#include "../src/includes/entities/factory.hpp"
+#include "../src/includes/systems/logic_system.hpp"
+#include "../src/includes/systems/lifetime_system.hpp"
+#include "../src/includes/core/command_buffer.hpp"
+#include "../src/includes/core/job_system.hpp"
+#include "../src/includes/core/physics_tasks.hpp"
+#include "../src/includes/core/spatial_grid.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+    constexpr float kUnitsPerMeter = 20.0f; // same scale as the game
+    constexpr float kTimeStep = 1.0f / 60.0f;
+    constexpr int kStackHeight = 5;         // short stacks settle fast
+    constexpr int kMaxSettleTicks = 60 * 60;
+    constexpr int kMeasureTicks = 600;
+
+    using Clock = std::chrono::steady_clock;
+
+    double Us(Clock::duration d)
+    {
+        return std::chrono::duration<double, std::micro>(d).count();
+    }
+
+    struct Phase
+    {
+        double logicUs{0.0}; // everything in the tick except b2World_Step
+        double stepUs{0.0};  // b2World_Step (Box2D profile)
+        std::size_t moved{0};
+        int ticks{0};
+
+        void print(const char *name) const
+        {
+            const double n = ticks > 0 ? ticks : 1;
+            std::printf("%-8s %5d ticks | logic %8.1f us/tick | box2d step %8.1f us/tick | moved %7.1f bodies/tick\n",
+                        name, ticks, logicUs / n, stepUs / n, moved / n);
+        }
+    };
+}
+
+int main(int argc, char **argv)
+{
+    SetTraceLogLevel(LOG_WARNING);
+    b2SetLengthUnitsPerMeter(kUnitsPerMeter);
+
+    const int boxCount = argc > 1 ? std::atoi(argv[1]) : 5000;
+    const int columns = (boxCount + kStackHeight - 1) / kStackHeight;
+
+    JobSystem jobs;
+    PhysicsTasks tasks{jobs};
+    b2WorldDef worldDef = b2DefaultWorldDef();
+    worldDef.gravity.y = 1.8f * kUnitsPerMeter;
+    tasks.configure(worldDef);
+    b2WorldId world = b2CreateWorld(&worldDef);
+
+    EntityManager entities;
+    ComponentStore store{entities};
+    store.pool<BodyPose>().setUnitsPerMeter(kUnitsPerMeter);
+    registerGamePools(store);
+
+    // Level: ground strip, stacks of boxes with a gap between stacks, spikes above
+    Sprite texture{};
+    b2Vec2 boxExtent = {8.0f, 8.0f};
+    b2Polygon boxPolygon = b2MakeBox(boxExtent.x / kUnitsPerMeter, boxExtent.y / kUnitsPerMeter);
+    const float pitch = boxExtent.x * 3.0f;
+    const float groundY = 1000.0f;
+    const float width = columns * pitch + 200.0f;
+    makeObstacleEntity(store, world, kUnitsPerMeter, {0.5f * width, 20.0f},
+                       {0.5f * width / kUnitsPerMeter, (groundY + 20.0f) / kUnitsPerMeter}, texture);
+    int placed = 0;
+    for (int col = 0; col < columns && placed < boxCount; ++col)
+    {
+        for (int row = 0; row < kStackHeight && placed < boxCount; ++row, ++placed)
+        {
+            b2Vec2 px = {100.0f + col * pitch, groundY - boxExtent.y - row * 2.0f * boxExtent.y};
+            makeBoxEntity(store, world, texture, boxPolygon, boxExtent,
+                          {px.x / kUnitsPerMeter, px.y / kUnitsPerMeter});
+        }
+    }
+    for (float x = 200.0f; x < width; x += 400.0f)
+        makeSpikeEntity(store, world, kUnitsPerMeter, 16.0f, {x / kUnitsPerMeter, 400.0f / kUnitsPerMeter}, texture);
+
+    CommandBuffer commands;
+    BodyPool projectilePool;
+    projectilePool.build(world, boxPolygon, ProjectileMaterial(), 8);
+    SpatialGrid grid{64.0f};
+
+    LogicContext logic{world, kUnitsPerMeter, store, projectilePool, commands,
+                       texture, boxPolygon, boxExtent, false};
+    logic.jobs = &jobs;
+    logic.grid = &grid;
+    LifetimeContext lifetime{store, commands, DespawnRules{}, {}};
+
+    auto tick = [&](Phase &phase)
+    {
+        auto start = Clock::now();
+        StepPhysics(logic, kTimeStep);
+        UpdateCapture(logic);
+        UpdateScripts(logic, kTimeStep);
+        UpdateLifetime(lifetime, kTimeStep);
+        commands.flush(store, world);
+        const double total = Us(Clock::now() - start);
+        const double step = 1000.0 * b2World_GetProfile(world).step;
+        phase.stepUs += step;
+        phase.logicUs += total > step ? total - step : 0.0;
+        phase.moved += store.pool<BodyPose>().moved().size();
+        ++phase.ticks;
+    };
+
+    Phase active;
+    int settleTicks = 0;
+    do
+    {
+        tick(active);
+    } while (!store.pool<BodyPose>().moved().empty() && ++settleTicks < kMaxSettleTicks);
+
+    std::printf("%d boxes in %d stacks, %zu tracked bodies\n", placed, columns, store.pool<BodyPose>().size());
+    if (!store.pool<BodyPose>().moved().empty())
+    {
+        std::printf("pile did not settle within %d ticks\n", kMaxSettleTicks);
+        b2DestroyWorld(world);
+        return 1;
+    }
+
+    Phase settled;
+    for (int i = 0; i < kMeasureTicks; ++i)
+        tick(settled);
+
+    active.print("falling");
+    settled.print("settled");
+
+    store.clear();
+    b2DestroyWorld(world);
+    return 0;
+}
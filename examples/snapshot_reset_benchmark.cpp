@@ -0,0 +1,116 @@
+/**
+ * Snapshot reset benchmark: how long a level reset (WorldSnapshot::restore) takes
+ *
+ * Loads a level into a headless Simulation (the demo level by default), takes
+ * a snapshot of its start, then repeats: play a couple of seconds with a few
+ * scripted throws (so there are projectiles, impale joints and merged boxes
+ * to tear down), restore the start and time the restore. Prints the p50, p99
+ * and worst reset time and exits with 1 if p99 is over the 1 ms budget, or
+ * if a restore fails. No window is opened.
+ *
+ * Compile with:
+ * g++ -O2 snapshot_reset_benchmark.cpp ../src/core/*.cpp -I../src -std=c++17 -pthread -lbox2d -lraylib -o snapshot_reset_benchmark
+ *
+ * Run (from the repository root, so the default level path resolves):
+ * ./examples/snapshot_reset_benchmark [level.toml] [resets]
+ */
+
+#include "box2d/box2d.h"
+#include "raylib.h"
+#include "../src/includes/core/simulation.hpp"
+#include "../src/includes/core/world_snapshot.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace
+{
+    constexpr float kUnitsPerMeter = 20.0f; // same scale as the game
+    constexpr int kPlayTicks = 120;         // two seconds of play between resets
+    constexpr int kThrowEvery = 30;         // ticks between scripted throws
+    constexpr double kBudgetMs = 1.0;
+
+    using Clock = std::chrono::steady_clock;
+
+    double Ms(Clock::duration d)
+    {
+        return std::chrono::duration<double, std::milli>(d).count();
+    }
+
+    // Nearest-rank percentile of sorted samples
+    double Percentile(const std::vector<double> &sorted, double p)
+    {
+        const std::size_t rank = static_cast<std::size_t>(std::ceil(p * sorted.size()));
+        return sorted[rank > 0 ? rank - 1 : 0];
+    }
+}
+
+int main(int argc, char **argv)
+{
+    SetTraceLogLevel(LOG_WARNING);
+    b2SetLengthUnitsPerMeter(kUnitsPerMeter);
+
+    const char *levelPath = argc > 1 ? argv[1] : "src/assets/levels/demo.toml";
+    const int resets = argc > 2 ? std::max(1, std::atoi(argv[2])) : 1000;
+
+    SimulationConfig config;
+    config.unitsPerMeter = kUnitsPerMeter;
+    Simulation sim{config};
+    if (!sim.loadLevel(levelPath))
+    {
+        std::printf("cannot load %s\n", levelPath);
+        return 1;
+    }
+
+    WorldSnapshot start;
+    sim.capture(start);
+
+    const EntityId thrower = sim.thrower();
+    const float maxPower = thrower ? sim.components().get<ThrowerContext>(thrower).maxPower : 0.0f;
+
+    std::vector<double> samples;
+    samples.reserve(resets);
+    for (int r = 0; r < resets; ++r)
+    {
+        for (int t = 0; t < kPlayTicks; ++t)
+        {
+            if (thrower && t % kThrowEvery == 0)
+            {
+                // Sweep angle and charge so resets see different worlds
+                const int shot = r * (kPlayTicks / kThrowEvery) + t / kThrowEvery;
+                const float angle = DEG2RAD * (-60.0f + 50.0f * static_cast<float>(shot % 11) / 10.0f);
+                const float charge = maxPower * (0.5f + 0.5f * static_cast<float>(shot % 7) / 6.0f);
+                sim.throwProjectile({cosf(angle), sinf(angle)}, charge);
+            }
+            sim.tick();
+        }
+
+        const auto begin = Clock::now();
+        const bool restored = sim.restore(start);
+        samples.push_back(Ms(Clock::now() - begin));
+        if (!restored)
+        {
+            std::printf("restore %d failed\n", r);
+            return 1;
+        }
+    }
+
+    std::sort(samples.begin(), samples.end());
+    const double p50 = Percentile(samples, 0.50);
+    const double p99 = Percentile(samples, 0.99);
+    std::printf("%s: %zu bodies in the snapshot, %d resets after %d ticks of play\n",
+                levelPath, start.bodyCount(), resets, kPlayTicks);
+    std::printf("reset  p50 %.3f ms | p99 %.3f ms | max %.3f ms | budget %.1f ms\n",
+                p50, p99, samples.back(), kBudgetMs);
+
+    if (p99 > kBudgetMs)
+    {
+        std::printf("p99 reset time is over budget\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,194 @@
+/**
+ * Spatial grid benchmark: SpatialGrid queries vs linear scans over the pose cache
+ *
+ * Scatters N points (1k, 10k, 100k by default) at a constant density, jitters
+ * them every step like moving bodies, and times the proximity queries the game
+ * needs both ways:
+ *   - radius:  boxes near each of 64 spikes (the old O(boxes x spikes) capture loop)
+ *   - aabb:    entities inside a 1280x720 camera view
+ *   - segment: entities within 30 px of an 800 px thrower aim line
+ * plus the cost of the incremental SpatialGrid::update() per step. Both sides
+ * must report the same match counts; exits with 1 otherwise. No window is opened.
+ *
+ * Compile with:
+ * g++ -O2 spatial_grid_benchmark.cpp ../src/core/spatial_grid.cpp -I../src -std=c++17 -lbox2d -o spatial_grid_benchmark
+ *
+ * Run:
+ * ./spatial_grid_benchmark [counts...]
+ */
+
+#include "../src/includes/core/pose_cache.hpp"
+#include "../src/includes/core/spatial_grid.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr int kSteps = 30;
+    constexpr int kSpikes = 64;
+    constexpr float kSpikeRadius = 40.0f;
+    constexpr float kPixelsPerEntity = 40.0f; // mean spacing: ~2.5 points per 64 px cell
+    constexpr float kCellSize = 64.0f;
+
+    using Clock = std::chrono::steady_clock;
+
+    double Ms(Clock::duration d)
+    {
+        return std::chrono::duration<double, std::milli>(d).count();
+    }
+
+    struct Timings
+    {
+        double update{0.0};
+        double radiusLinear{0.0}, radiusGrid{0.0};
+        double aabbLinear{0.0}, aabbGrid{0.0};
+        double segmentLinear{0.0}, segmentGrid{0.0};
+    };
+
+    // Same tests as SpatialGrid, written as the straight scans systems used to do
+    std::size_t LinearRadius(const PoseCache &poses, float x, float y, float r)
+    {
+        std::size_t n = 0;
+        const float *xs = poses.x();
+        const float *ys = poses.y();
+        for (std::size_t i = 0; i < poses.size(); ++i)
+        {
+            const float dx = xs[i] - x;
+            const float dy = ys[i] - y;
+            n += (dx * dx + dy * dy <= r * r) ? 1 : 0;
+        }
+        return n;
+    }
+
+    std::size_t LinearAabb(const PoseCache &poses, float minX, float minY, float maxX, float maxY)
+    {
+        std::size_t n = 0;
+        const float *xs = poses.x();
+        const float *ys = poses.y();
+        for (std::size_t i = 0; i < poses.size(); ++i)
+            n += (xs[i] >= minX && xs[i] <= maxX && ys[i] >= minY && ys[i] <= maxY) ? 1 : 0;
+        return n;
+    }
+
+    std::size_t LinearSegment(const PoseCache &poses, float ax, float ay, float bx, float by, float r)
+    {
+        std::size_t n = 0;
+        const float dx = bx - ax;
+        const float dy = by - ay;
+        const float lenSq = dx * dx + dy * dy;
+        const float *xs = poses.x();
+        const float *ys = poses.y();
+        for (std::size_t i = 0; i < poses.size(); ++i)
+        {
+            float t = std::clamp(((xs[i] - ax) * dx + (ys[i] - ay) * dy) / lenSq, 0.0f, 1.0f);
+            const float px = ax + dx * t - xs[i];
+            const float py = ay + dy * t - ys[i];
+            n += (px * px + py * py <= r * r) ? 1 : 0;
+        }
+        return n;
+    }
+
+    bool Run(std::size_t count)
+    {
+        std::mt19937 rng(1234);
+        const float side = std::sqrt(static_cast<float>(count)) * kPixelsPerEntity;
+        std::uniform_real_distribution<float> pos(0.0f, side);
+        std::uniform_real_distribution<float> jitter(-4.0f, 4.0f);
+
+        EntityManager em;
+        PoseCache poses;
+        for (std::size_t i = 0; i < count; ++i)
+            poses.add(em.create(), BodyPose{pos(rng), pos(rng), 1.0f, 0.0f});
+
+        std::vector<b2Vec2> spikes(kSpikes);
+        for (b2Vec2 &s : spikes)
+            s = {pos(rng), pos(rng)};
+
+        SpatialGrid grid{kCellSize};
+        grid.update(poses);
+        std::vector<EntityId> hits(count);
+
+        Timings t;
+        bool match = true;
+        for (int step = 0; step < kSteps; ++step)
+        {
+            // Move every body a little (a pose refresh), then sync the grid
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                BodyPose p = poses.at(i);
+                p.x = std::clamp(p.x + jitter(rng), 0.0f, side);
+                p.y = std::clamp(p.y + jitter(rng), 0.0f, side);
+                poses.add(poses.entity(i), p);
+            }
+            auto start = Clock::now();
+            grid.update(poses);
+            t.update += Ms(Clock::now() - start);
+
+            std::size_t linear = 0, indexed = 0;
+            start = Clock::now();
+            for (const b2Vec2 &s : spikes)
+                linear += LinearRadius(poses, s.x, s.y, kSpikeRadius);
+            t.radiusLinear += Ms(Clock::now() - start);
+            start = Clock::now();
+            for (const b2Vec2 &s : spikes)
+                indexed += grid.queryRadius(s.x, s.y, kSpikeRadius, hits.data(), hits.size());
+            t.radiusGrid += Ms(Clock::now() - start);
+            match = match && linear == indexed;
+
+            const float camX = side * 0.5f - 640.0f + step * 8.0f;
+            const float camY = side * 0.5f - 360.0f;
+            start = Clock::now();
+            linear = LinearAabb(poses, camX, camY, camX + 1280.0f, camY + 720.0f);
+            t.aabbLinear += Ms(Clock::now() - start);
+            start = Clock::now();
+            indexed = grid.queryAabb(camX, camY, camX + 1280.0f, camY + 720.0f, hits.data(), hits.size());
+            t.aabbGrid += Ms(Clock::now() - start);
+            match = match && linear == indexed;
+
+            const float angle = step * 0.2f;
+            const float ax = side * 0.5f;
+            const float ay = side * 0.5f;
+            const float bx = ax + std::cos(angle) * 800.0f;
+            const float by = ay + std::sin(angle) * 800.0f;
+            start = Clock::now();
+            linear = LinearSegment(poses, ax, ay, bx, by, 30.0f);
+            t.segmentLinear += Ms(Clock::now() - start);
+            start = Clock::now();
+            indexed = grid.querySegment(ax, ay, bx, by, 30.0f, hits.data(), hits.size());
+            t.segmentGrid += Ms(Clock::now() - start);
+            match = match && linear == indexed;
+        }
+
+        auto row = [](const char *name, double linear, double grid)
+        {
+            std::printf("  %-8s linear %9.4f ms   grid %9.4f ms   x%.1f\n",
+                        name, linear / kSteps, grid / kSteps, grid > 0.0 ? linear / grid : 0.0);
+        };
+        std::printf("%zu entities (%zu cells)%s\n", count, grid.cellCount(), match ? "" : "  MISMATCH");
+        std::printf("  update   %9.4f ms per step\n", t.update / kSteps);
+        row("radius", t.radiusLinear, t.radiusGrid);
+        row("aabb", t.aabbLinear, t.aabbGrid);
+        row("segment", t.segmentLinear, t.segmentGrid);
+        return match;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    std::vector<std::size_t> counts;
+    for (int i = 1; i < argc; ++i)
+        counts.push_back(static_cast<std::size_t>(std::strtoul(argv[i], nullptr, 10)));
+    if (counts.empty())
+        counts = {1000, 10000, 100000};
+
+    bool ok = true;
+    for (std::size_t count : counts)
+        ok = Run(count) && ok;
+    return ok ? 0 : 1;
+}
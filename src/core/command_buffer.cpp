@@ -0,0 +1,50 @@
+#include "../includes/core/command_buffer.hpp"
+#include "../includes/entities/factory.hpp"
+
+void CommandBuffer::flush(ComponentStore &store, b2WorldId world)
+{
+    for (EntityId owner : jointDestroys)
+    {
+        Impaled *impaled = store.tryGet<Impaled>(owner);
+        if (!impaled || !impaled->hasJoint())
+            continue;
+        if (b2Joint_IsValid(impaled->jointId))
+            b2DestroyJoint(impaled->jointId);
+        impaled->jointId = b2_nullJointId;
+    }
+
+    for (EntityId id : destroys)
+        destroyEntity(store, id); // no-op for ids already destroyed
+
+    for (EntityId id : merges)
+    {
+        if (store.isAlive(id))
+            consolidateEntity(store, id);
+    }
+
+    for (const ProjectileSpawn &p : projectiles)
+    {
+        EntityId proj = makeProjectileEntity(store, *p.pool, p.sprite, p.extent, p.pos);
+        b2Body_ApplyLinearImpulse(store.get<PhysicsBody>(proj).id, p.impulse, p.pos, true);
+    }
+
+    for (auto &fn : spawns)
+        fn(store);
+
+    for (auto &fn : componentOps)
+        fn(store);
+
+    for (const JointCommand &cmd : jointCreates)
+    {
+        Impaled *impaled = store.tryGet<Impaled>(cmd.owner);
+        if (!impaled)
+            continue; // owner died or never could hold a joint
+        if (impaled->hasJoint() && b2Joint_IsValid(impaled->jointId))
+            b2DestroyJoint(impaled->jointId);
+        impaled->jointId = (cmd.kind == JointCommand::Revolute)
+                               ? b2CreateRevoluteJoint(world, &cmd.revolute)
+                               : b2CreateDistanceJoint(world, &cmd.distance);
+    }
+
+    clear();
+}
@@ -0,0 +1,282 @@
+#include "../includes/core/input_trace.hpp"
+#include "../includes/core/pose_cache.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+    constexpr char kMagic[4] = {'I', 'M', 'P', 'T'};
+    constexpr uint32_t kVersion = 2; // 2: pointer in world pixels, camera at the screen centre
+
+    // Per-tick field mask; a byte with kIdleRun set is a run of unchanged ticks instead
+    enum : uint8_t
+    {
+        kPointer = 1u << 0,
+        kButtons = 1u << 1, // buttons byte (+ press position if Press)
+        kActions = 1u << 2,
+        kCamera = 1u << 3,
+        kIdleRun = 1u << 7 // low 7 bits: tick count
+    };
+
+    uint64_t Mix(uint64_t hash, uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            hash ^= (value >> (8 * i)) & 0xFFu;
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    uint32_t Bits(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof bits);
+        return bits;
+    }
+
+    float FromBits(uint32_t bits)
+    {
+        float value;
+        std::memcpy(&value, &bits, sizeof value);
+        return value;
+    }
+
+    struct Writer
+    {
+        std::vector<uint8_t> bytes;
+
+        void u8(uint8_t v) { bytes.push_back(v); }
+        void u16(uint16_t v)
+        {
+            u8(static_cast<uint8_t>(v));
+            u8(static_cast<uint8_t>(v >> 8));
+        }
+        void u32(uint32_t v)
+        {
+            u16(static_cast<uint16_t>(v));
+            u16(static_cast<uint16_t>(v >> 16));
+        }
+        void u64(uint64_t v)
+        {
+            u32(static_cast<uint32_t>(v));
+            u32(static_cast<uint32_t>(v >> 32));
+        }
+        void f32(float v) { u32(Bits(v)); }
+        void vec(Vector2 v)
+        {
+            f32(v.x);
+            f32(v.y);
+        }
+    };
+
+    struct Reader
+    {
+        const std::vector<uint8_t> &bytes;
+        std::size_t pos{0};
+        bool ok{true};
+
+        uint8_t u8()
+        {
+            if (pos >= bytes.size())
+            {
+                ok = false;
+                return 0;
+            }
+            return bytes[pos++];
+        }
+        uint16_t u16()
+        {
+            const uint16_t lo = u8();
+            return static_cast<uint16_t>(lo | (u8() << 8));
+        }
+        uint32_t u32()
+        {
+            const uint32_t lo = u16();
+            return lo | (static_cast<uint32_t>(u16()) << 16);
+        }
+        uint64_t u64()
+        {
+            const uint64_t lo = u32();
+            return lo | (static_cast<uint64_t>(u32()) << 32);
+        }
+        float f32() { return FromBits(u32()); }
+        Vector2 vec()
+        {
+            const float x = f32();
+            return {x, f32()};
+        }
+    };
+
+    bool Same(Vector2 a, Vector2 b) { return Bits(a.x) == Bits(b.x) && Bits(a.y) == Bits(b.y); }
+}
+
+uint64_t WorldChecksum(const ComponentStore &store)
+{
+    const PoseCache &poses = store.pool<BodyPose>();
+    uint64_t hash = 14695981039346656037ull;
+    hash = Mix(hash, static_cast<uint32_t>(poses.size()));
+    for (std::size_t i = 0; i < poses.size(); ++i)
+    {
+        const EntityId id = poses.entity(i);
+        hash = Mix(hash, id.index);
+        hash = Mix(hash, id.generation);
+        hash = Mix(hash, Bits(poses.x()[i]));
+        hash = Mix(hash, Bits(poses.y()[i]));
+        hash = Mix(hash, Bits(poses.cos()[i]));
+        hash = Mix(hash, Bits(poses.sin()[i]));
+    }
+    return hash;
+}
+
+void InputTrace::recordResult(const ComponentStore &store)
+{
+    if (checksumInterval > 0 && inputs.size() % checksumInterval == 0)
+        checksums.push_back(WorldChecksum(store));
+}
+
+bool InputTrace::verify(std::size_t ticks, const ComponentStore &store) const
+{
+    if (checksumInterval == 0 || ticks == 0 || ticks % checksumInterval != 0)
+        return true;
+    const std::size_t index = ticks / checksumInterval - 1;
+    return index >= checksums.size() || checksums[index] == WorldChecksum(store);
+}
+
+bool InputTrace::save(const std::string &path) const
+{
+    Writer out;
+    for (char c : kMagic)
+        out.u8(static_cast<uint8_t>(c));
+    out.u32(kVersion);
+    out.f32(hz);
+    out.u32(static_cast<uint32_t>(subSteps));
+    out.u32(checksumInterval);
+    out.u32(static_cast<uint32_t>(level.size()));
+    for (char c : level)
+        out.u8(static_cast<uint8_t>(c));
+    out.u32(static_cast<uint32_t>(inputs.size()));
+
+    TickInput last;
+    uint8_t idle = 0;
+    auto flushIdle = [&]
+    {
+        if (idle > 0)
+            out.u8(static_cast<uint8_t>(kIdleRun | idle));
+        idle = 0;
+    };
+    for (const TickInput &input : inputs)
+    {
+        uint8_t mask = 0;
+        if (!Same(input.pointer, last.pointer))
+            mask |= kPointer;
+        if (input.buttons != 0)
+            mask |= kButtons;
+        if (input.actions != 0)
+            mask |= kActions;
+        if (!Same(input.camera, last.camera))
+            mask |= kCamera;
+
+        if (mask == 0)
+        {
+            if (++idle == 127)
+                flushIdle();
+            continue;
+        }
+        flushIdle();
+        out.u8(mask);
+        if (mask & kPointer)
+            out.vec(input.pointer);
+        if (mask & kButtons)
+        {
+            out.u8(input.buttons);
+            if (input.pressed())
+                out.vec(input.press);
+        }
+        if (mask & kActions)
+            out.u16(input.actions);
+        if (mask & kCamera)
+            out.vec(input.camera);
+        last = input;
+    }
+    flushIdle();
+
+    out.u32(static_cast<uint32_t>(checksums.size()));
+    for (uint64_t sum : checksums)
+        out.u64(sum);
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(out.bytes.data()), static_cast<std::streamsize>(out.bytes.size()));
+    return static_cast<bool>(file);
+}
+
+bool InputTrace::load(const std::string &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        return false;
+    const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    Reader in{bytes};
+
+    for (char c : kMagic)
+    {
+        if (in.u8() != static_cast<uint8_t>(c))
+            return false;
+    }
+    if (in.u32() != kVersion)
+        return false;
+    hz = in.f32();
+    subSteps = static_cast<int>(in.u32());
+    checksumInterval = in.u32();
+    const uint32_t levelLength = in.u32();
+    if (!in.ok || levelLength > bytes.size())
+        return false;
+    level.assign(levelLength, '\0');
+    for (char &c : level)
+        c = static_cast<char>(in.u8());
+
+    const uint32_t count = in.u32();
+    if (!in.ok || count > bytes.size() * 127u)
+        return false;
+    inputs.clear();
+    inputs.reserve(count);
+    TickInput last;
+    while (inputs.size() < count && in.ok)
+    {
+        const uint8_t mask = in.u8();
+        TickInput input;
+        input.pointer = last.pointer;
+        input.camera = last.camera;
+        if (mask & kIdleRun)
+        {
+            // Unchanged ticks: same pointer and camera, no edges or actions
+            for (uint8_t i = 0; i < (mask & 0x7Fu) && inputs.size() < count; ++i)
+                inputs.push_back(input);
+            continue;
+        }
+        if (mask & kPointer)
+            input.pointer = in.vec();
+        if (mask & kButtons)
+        {
+            input.buttons = in.u8();
+            if (input.pressed())
+                input.press = in.vec();
+        }
+        if (mask & kActions)
+            input.actions = in.u16();
+        if (mask & kCamera)
+            input.camera = in.vec();
+        inputs.push_back(input);
+        last = input;
+    }
+
+    const uint32_t sums = in.u32();
+    if (!in.ok || sums > bytes.size() / 8u)
+        return false;
+    checksums.resize(sums);
+    for (uint64_t &sum : checksums)
+        sum = in.u64();
+    return in.ok && inputs.size() == count;
+}
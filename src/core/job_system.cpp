@@ -0,0 +1,211 @@
+#include "../includes/core/job_system.hpp"
+
+#include "raylib.h"
+
+namespace
+{
+    // Slot index of the current thread; outside threads stay at 0
+    thread_local uint32_t tlsSlot = 0;
+}
+
+unsigned JobSystem::DefaultWorkerCount()
+{
+#ifdef __EMSCRIPTEN__
+    return 0;
+#else
+    unsigned hw = std::thread::hardware_concurrency();
+    return hw > 1 ? hw - 1 : 0;
+#endif
+}
+
+JobSystem::JobSystem(unsigned workerCount)
+{
+#ifdef __EMSCRIPTEN__
+    workerCount = 0;
+#endif
+    slots.reserve(workerCount + 1);
+    for (unsigned i = 0; i < workerCount + 1; ++i)
+        slots.push_back(std::make_unique<Slot>());
+
+    statsStart = std::chrono::steady_clock::now();
+
+    threads.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; ++i)
+        threads.emplace_back([this, i]
+                             { workerLoop(i + 1); });
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    sleepCv.notify_all();
+    for (std::thread &t : threads)
+        t.join();
+}
+
+uint32_t JobSystem::currentSlot()
+{
+    return tlsSlot;
+}
+
+void JobSystem::submit(TaskFn fn, void *context, uint32_t begin, uint32_t end, JobCounter *counter)
+{
+    if (counter)
+        counter->pending.fetch_add(1, std::memory_order_relaxed);
+    push(Job{fn, context, begin, end, counter});
+}
+
+void JobSystem::submit(std::function<void()> fn, JobCounter *counter)
+{
+    // The closure owns itself and is freed after running
+    auto *heapFn = new std::function<void()>(std::move(fn));
+    TaskFn task = [](uint32_t, uint32_t, uint32_t, void *context)
+    {
+        auto *f = static_cast<std::function<void()> *>(context);
+        (*f)();
+        delete f;
+    };
+    submit(task, heapFn, 0, 1, counter);
+}
+
+void JobSystem::wait(JobCounter &counter)
+{
+    while (!counter.done())
+    {
+        if (!runOne())
+            std::this_thread::yield(); // remaining jobs are running elsewhere
+    }
+}
+
+bool JobSystem::runOne()
+{
+    const uint32_t slot = currentSlot();
+    Job job;
+    if (pop(slot, job) || steal(slot, job))
+    {
+        execute(slot, job);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::push(const Job &job)
+{
+    Slot &own = *slots[currentSlot()];
+    {
+        std::lock_guard<std::mutex> lock(own.mutex);
+        own.queue.push_back(job);
+    }
+    queued.fetch_add(1, std::memory_order_release);
+
+    // Taking the sleep mutex orders this push against a worker about to sleep
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    sleepCv.notify_one();
+}
+
+bool JobSystem::pop(uint32_t slot, Job &job)
+{
+    Slot &own = *slots[slot];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (own.queue.empty())
+        return false;
+    job = own.queue.back(); // newest first: its data is still in cache
+    own.queue.pop_back();
+    queued.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool JobSystem::steal(uint32_t thief, Job &job)
+{
+    const uint32_t n = static_cast<uint32_t>(slots.size());
+    for (uint32_t k = 1; k < n; ++k)
+    {
+        Slot &victim = *slots[(thief + k) % n];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.queue.empty())
+            continue;
+        job = victim.queue.front(); // oldest first: usually the largest remaining work
+        victim.queue.pop_front();
+        queued.fetch_sub(1, std::memory_order_relaxed);
+        slots[thief]->steals.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void JobSystem::execute(uint32_t slot, const Job &job)
+{
+    auto start = std::chrono::steady_clock::now();
+    job.fn(job.begin, job.end, slot, job.context);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    Slot &s = *slots[slot];
+    s.busyNs.fetch_add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+                       std::memory_order_relaxed);
+    s.jobs.fetch_add(1, std::memory_order_relaxed);
+
+    if (job.counter)
+        job.counter->pending.fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::workerLoop(uint32_t slot)
+{
+    tlsSlot = slot;
+    for (;;)
+    {
+        Job job;
+        if (pop(slot, job) || steal(slot, job))
+        {
+            execute(slot, job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepCv.wait(lock, [this]
+                     { return stopping.load() || queued.load(std::memory_order_acquire) > 0; });
+        if (stopping)
+            return;
+    }
+}
+
+std::vector<JobSystem::SlotStats> JobSystem::stats() const
+{
+    const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - statsStart).count();
+    std::vector<SlotStats> out(slots.size());
+    for (std::size_t i = 0; i < slots.size(); ++i)
+    {
+        const Slot &s = *slots[i];
+        out[i].jobs = s.jobs.load(std::memory_order_relaxed);
+        out[i].steals = s.steals.load(std::memory_order_relaxed);
+        out[i].busySeconds = static_cast<double>(s.busyNs.load(std::memory_order_relaxed)) * 1e-9;
+        out[i].utilization = wall > 0.0 ? static_cast<float>(out[i].busySeconds / wall) : 0.0f;
+    }
+    return out;
+}
+
+void JobSystem::resetStats()
+{
+    for (auto &s : slots)
+    {
+        s->busyNs = 0;
+        s->jobs = 0;
+        s->steals = 0;
+    }
+    statsStart = std::chrono::steady_clock::now();
+}
+
+void JobSystem::logUtilization() const
+{
+    std::vector<SlotStats> all = stats();
+    for (std::size_t i = 0; i < all.size(); ++i)
+    {
+        TraceLog(LOG_INFO, "Jobs: slot %d%s %5.1f%% busy, %llu jobs, %llu steals",
+                 (int)i, i == 0 ? " (main)" : "       ", all[i].utilization * 100.0f,
+                 (unsigned long long)all[i].jobs, (unsigned long long)all[i].steals);
+    }
+}
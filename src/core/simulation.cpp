@@ -0,0 +1,146 @@
+#include "../includes/core/simulation.hpp"
+#include "../includes/core/world_loader.hpp"
+
+#include <cmath>
+#include <mutex>
+
+namespace
+{
+    // Box2D hands out world ids from a global table without locking, so worlds
+    // created or destroyed from several threads at once take turns
+    std::mutex worldTableMutex;
+
+    b2WorldId CreateWorld(const SimulationConfig &config)
+    {
+        b2WorldDef def = b2DefaultWorldDef();
+        def.gravity.y = 1.8f * config.unitsPerMeter; // same as the game
+        std::lock_guard<std::mutex> lock(worldTableMutex);
+        return b2CreateWorld(&def);
+    }
+}
+
+Simulation::Simulation(const SimulationConfig &config)
+    : cfg(config),
+      worldId(CreateWorld(config)),
+      groundPolygon(b2MakeBox(config.groundExtentPx.x / config.unitsPerMeter, config.groundExtentPx.y / config.unitsPerMeter)),
+      boxPolygon(b2MakeBox(config.boxExtentPx.x / config.unitsPerMeter, config.boxExtentPx.y / config.unitsPerMeter)),
+      boxExtent(config.boxExtentPx),
+      logicCtx{worldId, config.unitsPerMeter, store, projectilePool, commands,
+               emptySprite, boxPolygon, boxExtent, false},
+      lifetimeCtx{store, commands, config.despawn, {}},
+      consolidationCtx{store, commands},
+      chainLodCtx{store, worldId, config.unitsPerMeter}
+{
+    store.pool<BodyPose>().setUnitsPerMeter(cfg.unitsPerMeter);
+    registerGamePools(store);
+    logicCtx.grid = &grid;
+    chainLodCtx.grid = &grid;
+    logicCtx.subSteps = cfg.subSteps;
+    chainLodCtx.view = cfg.view;
+}
+
+Simulation::~Simulation()
+{
+    store.clear();
+    std::lock_guard<std::mutex> lock(worldTableMutex);
+    b2DestroyWorld(worldId);
+}
+
+bool Simulation::loadLevel(const std::string &path)
+{
+    level::BuildContext ctx{store, worldId, cfg.unitsPerMeter,
+                            emptySprite, emptySprite,
+                            groundPolygon, boxPolygon,
+                            cfg.groundExtentPx, boxExtent,
+                            [](const std::string &)
+                            { return Sprite{}; }};
+    if (!level::LoadScenarioFromToml(path, ctx))
+        return false;
+
+    // Same projectile budget as the game: the despawn cap plus one flush of headroom
+    const std::size_t capacity = lifetimeCtx.rules.maxCount + 8;
+    projectilePool.build(worldId, boxPolygon, ProjectileMaterial(), capacity);
+    reserveProjectiles(store, capacity);
+    levelStart.capture(store);
+    return true;
+}
+
+void Simulation::tick()
+{
+    const float step = dt();
+    const bool paused = logicCtx.isPaused;
+    StepPhysics(logicCtx, step);
+    UpdateCapture(logicCtx);
+    if (!paused)
+        UpdateConsolidation(consolidationCtx);
+    UpdateScripts(logicCtx, step);
+    if (!paused)
+        UpdateLifetime(lifetimeCtx, step);
+    commands.flush(store, worldId);
+    if (!paused)
+        UpdateChainLod(chainLodCtx, step);
+    ++ticks;
+}
+
+void Simulation::apply(const TickInput &input)
+{
+    chainLodCtx.view = input.view({cfg.view.width, cfg.view.height});
+    if (input.has(TickInput::TogglePause))
+        logicCtx.isPaused = !logicCtx.isPaused;
+    if (input.has(TickInput::ToggleConsolidation))
+        consolidationCtx.enabled = !consolidationCtx.enabled;
+    if (input.has(TickInput::ToggleChainLod))
+        chainLodCtx.enabled = !chainLodCtx.enabled;
+
+    // Player resets and loads keep the tick counter running (unlike restore())
+    if (input.has(TickInput::Reset))
+    {
+        commands.clear();
+        levelStart.restore(store, worldId, cfg.unitsPerMeter);
+    }
+    if (input.has(TickInput::QuickSave))
+        quickSave.capture(store);
+    if (input.has(TickInput::QuickLoad))
+    {
+        commands.clear();
+        quickSave.restore(store, worldId, cfg.unitsPerMeter);
+    }
+
+    UpdateThrower(logicCtx, input);
+}
+
+EntityId Simulation::thrower() const
+{
+    const auto &throwers = store.pool<ThrowerTag>();
+    return throwers.empty() ? EntityId{} : throwers.entity(0);
+}
+
+bool Simulation::throwProjectile(b2Vec2 aimDir, float charge)
+{
+    const EntityId id = thrower();
+    ThrowerContext *thrower = id ? store.tryGet<ThrowerContext>(id) : nullptr;
+    const float len = sqrtf(aimDir.x * aimDir.x + aimDir.y * aimDir.y);
+    if (!thrower || len <= 0.0f)
+        return false;
+
+    thrower->aimDir = {aimDir.x / len, aimDir.y / len};
+    thrower->currentCharge = charge < thrower->maxPower ? charge : thrower->maxPower;
+    FireThrower(logicCtx, id, *thrower);
+    thrower->currentCharge = 0.0f;
+    return true;
+}
+
+void Simulation::capture(WorldSnapshot &snapshot) const
+{
+    snapshot.capture(store);
+    snapshot.tick = ticks;
+}
+
+bool Simulation::restore(const WorldSnapshot &snapshot)
+{
+    commands.clear();
+    if (!snapshot.restore(store, worldId, cfg.unitsPerMeter))
+        return false;
+    ticks = snapshot.tick;
+    return true;
+}
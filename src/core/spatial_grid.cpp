@@ -0,0 +1,305 @@
+#include "../includes/core/spatial_grid.hpp"
+#include "../includes/core/pose_cache.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(float cellSize)
+    : cell(cellSize > 0.0f ? cellSize : 64.0f), invCell(1.0f / cell)
+{
+}
+
+void SpatialGrid::setCellSize(float cellSize)
+{
+    if (cellSize <= 0.0f || cellSize == cell)
+        return;
+    cell = cellSize;
+    invCell = 1.0f / cell;
+
+    cells.clear();
+    for (uint32_t slot = 0; slot < items.size(); ++slot)
+    {
+        Item &item = items[slot];
+        item.cell = pack(cellCoord(item.x), cellCoord(item.y));
+        link(slot);
+    }
+}
+
+int32_t SpatialGrid::cellCoord(float v) const
+{
+    return static_cast<int32_t>(std::floor(v * invCell));
+}
+
+void SpatialGrid::link(uint32_t slot)
+{
+    std::vector<uint32_t> &bucket = cells[items[slot].cell];
+    items[slot].bucket = static_cast<uint32_t>(bucket.size());
+    bucket.push_back(slot);
+}
+
+void SpatialGrid::unlink(uint32_t slot)
+{
+    std::vector<uint32_t> &bucket = cells[items[slot].cell];
+    const uint32_t pos = items[slot].bucket;
+    const uint32_t moved = bucket.back();
+    bucket[pos] = moved;
+    items[moved].bucket = pos;
+    bucket.pop_back(); // empty buckets stay allocated for the next visitor
+}
+
+void SpatialGrid::erase(uint32_t slot)
+{
+    unlink(slot);
+    sparse[items[slot].id.index] = npos;
+
+    const uint32_t last = static_cast<uint32_t>(items.size() - 1);
+    if (slot != last)
+    {
+        // Move the last item into the hole and repoint its bucket entry
+        items[slot] = items[last];
+        cells[items[slot].cell][items[slot].bucket] = slot;
+        sparse[items[slot].id.index] = slot;
+    }
+    items.pop_back();
+}
+
+void SpatialGrid::place(EntityId id, float x, float y, uint32_t stamp)
+{
+    if (id.index >= sparse.size())
+        sparse.resize(id.index + 1, npos);
+
+    const uint64_t key = pack(cellCoord(x), cellCoord(y));
+    uint32_t slot = sparse[id.index];
+    if (slot != npos && items[slot].id != id)
+    {
+        erase(slot); // stale generation: index was recycled
+        slot = npos;
+    }
+
+    if (slot == npos)
+    {
+        slot = static_cast<uint32_t>(items.size());
+        sparse[id.index] = slot;
+        items.push_back(Item{id, x, y, key, 0u, stamp});
+        link(slot);
+        return;
+    }
+
+    Item &item = items[slot];
+    item.x = x;
+    item.y = y;
+    item.stamp = stamp;
+    if (item.cell != key)
+    {
+        unlink(slot);
+        item.cell = key;
+        link(slot);
+    }
+}
+
+void SpatialGrid::update(const PoseCache &poses)
+{
+    // Same entity set as last time: only this step's movers can change cell
+    if (synced && poses.structureVersion() == syncedVersion)
+    {
+        for (EntityId id : poses.moved())
+        {
+            if (!poses.has(id))
+                continue;
+            const BodyPose pose = poses.get(id);
+            place(id, pose.x, pose.y, epoch);
+        }
+        return;
+    }
+    synced = true;
+    syncedVersion = poses.structureVersion();
+
+    const uint32_t stamp = ++epoch;
+    const float *xs = poses.x();
+    const float *ys = poses.y();
+    const std::size_t count = poses.size();
+    for (std::size_t i = 0; i < count; ++i)
+        place(poses.entity(i), xs[i], ys[i], stamp);
+
+    // Anything not seen this pass lost its pose (destroyed or untracked)
+    if (items.size() > count)
+    {
+        for (uint32_t slot = static_cast<uint32_t>(items.size()); slot-- > 0;)
+        {
+            if (items[slot].stamp != stamp)
+                erase(slot);
+        }
+    }
+
+    // Drop empty buckets once they clearly outnumber the live ones
+    if (cells.size() > items.size() * 2 + 64)
+    {
+        for (auto it = cells.begin(); it != cells.end();)
+        {
+            if (it->second.empty())
+                it = cells.erase(it);
+            else
+                ++it;
+        }
+    }
+}
+
+void SpatialGrid::insert(EntityId id, float x, float y)
+{
+    place(id, x, y, epoch);
+}
+
+void SpatialGrid::move(EntityId id, float x, float y)
+{
+    place(id, x, y, epoch);
+}
+
+void SpatialGrid::remove(EntityId id)
+{
+    if (contains(id))
+        erase(sparse[id.index]);
+}
+
+bool SpatialGrid::contains(EntityId id) const
+{
+    return id.index < sparse.size() && sparse[id.index] != npos && items[sparse[id.index]].id == id;
+}
+
+void SpatialGrid::clear()
+{
+    sparse.clear();
+    items.clear();
+    cells.clear();
+    synced = false; // next update() is a full pass
+}
+
+template <typename Fn>
+void SpatialGrid::forCells(int32_t cx0, int32_t cy0, int32_t cx1, int32_t cy1, Fn &&fn) const
+{
+    const uint64_t span = static_cast<uint64_t>(cx1 - cx0 + 1) * static_cast<uint64_t>(cy1 - cy0 + 1);
+    if (span > cells.size())
+    {
+        // Range covers more cells than exist: walk the occupied ones instead
+        for (const auto &entry : cells)
+        {
+            const int32_t cx = static_cast<int32_t>(static_cast<uint32_t>(entry.first >> 32));
+            const int32_t cy = static_cast<int32_t>(static_cast<uint32_t>(entry.first));
+            if (cx < cx0 || cx > cx1 || cy < cy0 || cy > cy1)
+                continue;
+            for (uint32_t slot : entry.second)
+                fn(items[slot]);
+        }
+        return;
+    }
+
+    for (int32_t cx = cx0; cx <= cx1; ++cx)
+    {
+        for (int32_t cy = cy0; cy <= cy1; ++cy)
+        {
+            auto it = cells.find(pack(cx, cy));
+            if (it == cells.end())
+                continue;
+            for (uint32_t slot : it->second)
+                fn(items[slot]);
+        }
+    }
+}
+
+std::size_t SpatialGrid::queryRadius(float x, float y, float radius, EntityId *out, std::size_t capacity) const
+{
+    std::size_t found = 0;
+    const float r2 = radius * radius;
+    forCells(cellCoord(x - radius), cellCoord(y - radius), cellCoord(x + radius), cellCoord(y + radius),
+             [&](const Item &item)
+             {
+                 const float dx = item.x - x;
+                 const float dy = item.y - y;
+                 if (dx * dx + dy * dy > r2)
+                     return;
+                 if (found < capacity)
+                     out[found] = item.id;
+                 ++found;
+             });
+    return found;
+}
+
+std::size_t SpatialGrid::queryAabb(float minX, float minY, float maxX, float maxY, EntityId *out, std::size_t capacity) const
+{
+    std::size_t found = 0;
+    forCells(cellCoord(minX), cellCoord(minY), cellCoord(maxX), cellCoord(maxY),
+             [&](const Item &item)
+             {
+                 if (item.x < minX || item.x > maxX || item.y < minY || item.y > maxY)
+                     return;
+                 if (found < capacity)
+                     out[found] = item.id;
+                 ++found;
+             });
+    return found;
+}
+
+std::size_t SpatialGrid::querySegment(float ax, float ay, float bx, float by, float radius, EntityId *out, std::size_t capacity) const
+{
+    std::size_t found = 0;
+    const float dx = bx - ax;
+    const float dy = by - ay;
+    const float lenSq = dx * dx + dy * dy;
+    const float r2 = radius * radius;
+    auto test = [&](const Item &item)
+    {
+        // Distance from the point to the closest point on the segment
+        float t = lenSq > 0.0f ? ((item.x - ax) * dx + (item.y - ay) * dy) / lenSq : 0.0f;
+        t = std::clamp(t, 0.0f, 1.0f);
+        const float px = ax + dx * t - item.x;
+        const float py = ay + dy * t - item.y;
+        if (px * px + py * py > r2)
+            return;
+        if (found < capacity)
+            out[found] = item.id;
+        ++found;
+    };
+
+    // Walk the columns the capsule crosses; in each, only the rows the segment
+    // spans over that column (plus radius). Every cell is visited at most once.
+    const float segMinX = std::min(ax, bx);
+    const float segMaxX = std::max(ax, bx);
+    const int32_t cx0 = cellCoord(segMinX - radius);
+    const int32_t cx1 = cellCoord(segMaxX + radius);
+    auto rows = [&](int32_t cx, int32_t &cy0, int32_t &cy1)
+    {
+        const float slabMin = std::max(segMinX, cx * cell - radius);
+        const float slabMax = std::min(segMaxX, (cx + 1) * cell + radius);
+        float y0 = ay;
+        float y1 = by;
+        if (dx != 0.0f)
+        {
+            y0 = ay + dy * ((slabMin - ax) / dx);
+            y1 = ay + dy * ((slabMax - ax) / dx);
+        }
+        cy0 = cellCoord(std::min(y0, y1) - radius);
+        cy1 = cellCoord(std::max(y0, y1) + radius);
+    };
+
+    // Decide once for the whole segment: when its cells outnumber the occupied
+    // ones, a single pass over the occupied cells is cheaper than the columns
+    uint64_t span = 0;
+    for (int32_t cx = cx0; cx <= cx1 && span <= cells.size(); ++cx)
+    {
+        int32_t cy0, cy1;
+        rows(cx, cy0, cy1);
+        span += static_cast<uint64_t>(cy1 - cy0 + 1);
+    }
+    if (span > cells.size())
+    {
+        forCells(cx0, cellCoord(std::min(ay, by) - radius), cx1, cellCoord(std::max(ay, by) + radius), test);
+        return found;
+    }
+
+    for (int32_t cx = cx0; cx <= cx1; ++cx)
+    {
+        int32_t cy0, cy1;
+        rows(cx, cy0, cy1);
+        forCells(cx, cy0, cx, cy1, test); // within the total span: direct lookups
+    }
+    return found;
+}
@@ -0,0 +1,236 @@
+#include "../includes/core/texture_atlas.hpp"
+
+#include "toml.hpp" // toml11
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+
+namespace
+{
+    int NextPowerOfTwo(int value)
+    {
+        int p = 1;
+        while (p < value)
+            p <<= 1;
+        return p;
+    }
+
+    std::string DirectoryOf(const std::string &path)
+    {
+        const std::size_t slash = path.find_last_of("/\\");
+        return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+    }
+
+    int GetInt(const toml::value &v, const char *key)
+    {
+        return static_cast<int>(toml::find<std::int64_t>(v, key));
+    }
+
+    // Copy `src` into the page at `at`, then repeat its outermost rows and
+    // columns into the padding so filtering at the region's edge never reads a
+    // neighbour
+    void Blit(Image &page, const Image &src, Rectangle at, int padding)
+    {
+        const float w = static_cast<float>(src.width);
+        const float h = static_cast<float>(src.height);
+        const float p = static_cast<float>(padding);
+        ImageDraw(&page, src, {0, 0, w, h}, at, WHITE);
+        if (padding <= 0)
+            return;
+        ImageDraw(&page, src, {0, 0, w, 1}, {at.x, at.y - p, w, p}, WHITE);
+        ImageDraw(&page, src, {0, h - 1, w, 1}, {at.x, at.y + h, w, p}, WHITE);
+        ImageDraw(&page, src, {0, 0, 1, h}, {at.x - p, at.y, p, h}, WHITE);
+        ImageDraw(&page, src, {w - 1, 0, 1, h}, {at.x + w, at.y, p, h}, WHITE);
+        ImageDraw(&page, src, {0, 0, 1, 1}, {at.x - p, at.y - p, p, p}, WHITE);
+        ImageDraw(&page, src, {w - 1, 0, 1, 1}, {at.x + w, at.y - p, p, p}, WHITE);
+        ImageDraw(&page, src, {0, h - 1, 1, 1}, {at.x - p, at.y + h, p, p}, WHITE);
+        ImageDraw(&page, src, {w - 1, h - 1, 1, 1}, {at.x + w, at.y + h, p, p}, WHITE);
+    }
+}
+
+std::string TextureAtlas::Key(const std::string &path)
+{
+    std::string key = path;
+    std::replace(key.begin(), key.end(), '\\', '/');
+    while (key.compare(0, 2, "./") == 0)
+        key.erase(0, 2);
+    if (key.compare(0, 8, "/assets/") == 0)
+        key.erase(0, 8);
+    else if (key.compare(0, 7, "assets/") == 0)
+        key.erase(0, 7);
+    return key;
+}
+
+bool TextureAtlas::load(const std::string &manifestPath)
+{
+    unload();
+    if (!FileExists(manifestPath.c_str()))
+        return false;
+
+    toml::value data;
+    try
+    {
+        data = toml::parse(manifestPath);
+        const std::string dir = DirectoryOf(manifestPath);
+        for (const toml::value &page : toml::find<toml::array>(data, "pages"))
+        {
+            const std::string file = dir + toml::get<std::string>(page);
+            Texture texture = FileExists(file.c_str()) ? LoadTexture(file.c_str()) : Texture{};
+            if (texture.id == 0)
+            {
+                TraceLog(LOG_WARNING, "Atlas page %s cannot be loaded", file.c_str());
+                unload();
+                return false;
+            }
+            pages.push_back(texture);
+        }
+        for (const toml::value &region : toml::find_or(data, "region", toml::array{}))
+        {
+            const int page = GetInt(region, "page");
+            if (page < 0 || page >= static_cast<int>(pages.size()))
+                continue;
+            const Rectangle rect = {(float)GetInt(region, "x"), (float)GetInt(region, "y"),
+                                    (float)GetInt(region, "width"), (float)GetInt(region, "height")};
+            regions[Key(toml::find<std::string>(region, "path"))] = Sprite{pages[page], rect};
+        }
+    }
+    catch (const std::exception &e)
+    {
+        std::fprintf(stderr, "Failed to parse %s: %s\n", manifestPath.c_str(), e.what());
+        unload();
+        return false;
+    }
+    return true;
+}
+
+void TextureAtlas::unload()
+{
+    for (Texture &page : pages)
+        UnloadTexture(page);
+    pages.clear();
+    regions.clear();
+}
+
+const Sprite *TextureAtlas::find(const std::string &path) const
+{
+    auto it = regions.find(Key(path));
+    return it == regions.end() ? nullptr : &it->second;
+}
+
+std::vector<AtlasPlacement> PackAtlas(const std::vector<Vector2> &sizes, const AtlasBuildOptions &options,
+                                      std::vector<Vector2> &pageSizes)
+{
+    std::vector<AtlasPlacement> placements(sizes.size());
+    pageSizes.clear();
+
+    std::vector<std::size_t> order(sizes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&sizes](std::size_t a, std::size_t b)
+                     { return sizes[a].y != sizes[b].y ? sizes[a].y > sizes[b].y : sizes[a].x > sizes[b].x; });
+
+    // Only the last page is open: x along the current shelf, shelves stacked in y
+    const int pad = options.padding;
+    int page = -1;
+    int x = 0, shelfY = 0, shelfH = 0;
+    for (std::size_t i : order)
+    {
+        const int w = static_cast<int>(sizes[i].x) + 2 * pad;
+        const int h = static_cast<int>(sizes[i].y) + 2 * pad;
+        if (w > options.pageSize || h > options.pageSize)
+            continue;
+        if (page >= 0 && x + w > options.pageSize)
+        {
+            shelfY += shelfH;
+            x = 0;
+            shelfH = 0;
+        }
+        if (page < 0 || shelfY + h > options.pageSize)
+        {
+            ++page;
+            pageSizes.push_back({0, 0});
+            x = shelfY = shelfH = 0;
+        }
+        placements[i] = {page, {(float)(x + pad), (float)(shelfY + pad), sizes[i].x, sizes[i].y}};
+        x += w;
+        shelfH = std::max(shelfH, h);
+        pageSizes[page].x = std::max(pageSizes[page].x, (float)x);
+        pageSizes[page].y = std::max(pageSizes[page].y, (float)(shelfY + shelfH));
+    }
+    return placements;
+}
+
+int BuildAtlas(const std::string &root, const std::vector<std::string> &images, const std::string &outputDir,
+               const AtlasBuildOptions &options)
+{
+    const std::string base = root.empty() || root.back() == '/' ? root : root + "/";
+    const std::string out = outputDir.empty() || outputDir.back() == '/' ? outputDir : outputDir + "/";
+
+    std::vector<std::string> keys;
+    std::vector<Image> sources;
+    std::vector<Vector2> sizes;
+    for (const std::string &path : images)
+    {
+        Image image = LoadImage((base + path).c_str());
+        if (!IsImageValid(image))
+        {
+            TraceLog(LOG_WARNING, "Atlas: cannot read %s", (base + path).c_str());
+            continue;
+        }
+        if (image.width > options.maxImageSize || image.height > options.maxImageSize)
+        {
+            TraceLog(LOG_INFO, "Atlas: %s (%dx%d) stays a separate texture", path.c_str(), image.width, image.height);
+            UnloadImage(image);
+            continue;
+        }
+        keys.push_back(TextureAtlas::Key(path));
+        sources.push_back(image);
+        sizes.push_back({(float)image.width, (float)image.height});
+    }
+
+    std::vector<Vector2> pageSizes;
+    const std::vector<AtlasPlacement> placements = PackAtlas(sizes, options, pageSizes);
+
+    // Pages are power-of-two sized (GLES2/WebGL1 textures with the default wrap mode)
+    std::vector<Image> pages;
+    for (const Vector2 &size : pageSizes)
+        pages.push_back(GenImageColor(NextPowerOfTwo((int)size.x), NextPowerOfTwo((int)size.y), BLANK));
+    for (std::size_t i = 0; i < sources.size(); ++i)
+    {
+        if (placements[i].page >= 0)
+            Blit(pages[placements[i].page], sources[i], placements[i].rect, options.padding);
+        UnloadImage(sources[i]);
+    }
+
+    bool written = true;
+    std::ofstream manifest(out + "atlas.toml", std::ios::trunc);
+    manifest << "# Generated by the-impale-atlas from " << root << "; do not edit\n";
+    manifest << "pages = [";
+    for (std::size_t p = 0; p < pages.size(); ++p)
+    {
+        const std::string file = "atlas_" + std::to_string(p) + ".png";
+        written = ExportImage(pages[p], (out + file).c_str()) && written;
+        UnloadImage(pages[p]);
+        manifest << (p ? ", " : "") << '"' << file << '"';
+    }
+    manifest << "]\n";
+
+    int packed = 0;
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+        const AtlasPlacement &place = placements[i];
+        if (place.page < 0)
+            continue;
+        manifest << "\n[[region]]\n"
+                 << "path = \"" << keys[i] << "\"\n"
+                 << "page = " << place.page << "\n"
+                 << "x = " << (int)place.rect.x << "\n"
+                 << "y = " << (int)place.rect.y << "\n"
+                 << "width = " << (int)place.rect.width << "\n"
+                 << "height = " << (int)place.rect.height << "\n";
+        ++packed;
+    }
+    manifest.flush();
+    return written && manifest ? packed : -1;
+}
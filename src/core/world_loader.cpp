@@ -100,6 +100,7 @@ namespace level
             props.type = parseSpikeType(typeStr);
         }
         props.rotationSpeed = getFloatOr(v, "rotationSpeed", 90.0f); // default 90 deg/sec for saws
+        props.teeth = static_cast<int>(getFloatOr(v, "teeth", static_cast<float>(props.teeth)));
         props.chainLength = getFloatOr(v, "chainLength", 50.0f);
         // Optional chain-specific tuning
         props.linkLengthPx = getFloatOr(v, "linkLengthPx", props.linkLengthPx);
@@ -113,6 +114,7 @@ namespace level
         props.jointDamping = getFloatOr(v, "jointDamping", props.jointDamping);
         if (v.contains("chainSelfCollide"))
             props.chainSelfCollide = toml::find<bool>(v, "chainSelfCollide");
+        props.jointBudget = static_cast<int>(getFloatOr(v, "jointBudget", static_cast<float>(props.jointBudget)));
         return props;
     }
 
@@ -153,12 +155,12 @@ namespace level
 
                 // Load texture for this obstacle (fallback to default)
                 std::string texturePath = parseTexturePath(v, "texture", "ground.png");
-                Texture obstacleTexture = ctx.textureLoader ? ctx.textureLoader(texturePath) : ctx.groundTexture;
+                Sprite obstacleSprite = ctx.textureLoader ? ctx.textureLoader(texturePath) : ctx.groundSprite;
 
                 // Create polygon for this obstacle size
                 b2Polygon obstaclePoly = b2MakeBox(extentPx.x / ctx.unitsPerMeter, extentPx.y / ctx.unitsPerMeter);
 
-                ctx.obstacles.push_back(makeObstacleEntity(ctx.em, ctx.world, ctx.unitsPerMeter, extentPx, posM, obstacleTexture, visual));
+                makeObstacleEntity(ctx.store, ctx.world, ctx.unitsPerMeter, extentPx, posM, obstacleSprite, visual);
             }
         }
 
@@ -177,9 +179,9 @@ namespace level
 
                 // Load texture for this spike (fallback to box texture)
                 std::string texturePath = parseTexturePath(v, "texture", "box.png");
-                Texture spikeTexture = ctx.textureLoader ? ctx.textureLoader(texturePath) : ctx.boxTexture;
+                Sprite spikeSprite = ctx.textureLoader ? ctx.textureLoader(texturePath) : ctx.boxSprite;
 
-                ctx.spikes.push_back(makeSpikeEntity(ctx.em, ctx.world, ctx.unitsPerMeter, r, posM, spikeTexture, spikeProps, visual));
+                makeSpikeEntity(ctx.store, ctx.world, ctx.unitsPerMeter, r, posM, spikeSprite, spikeProps, visual);
             }
         }
 
@@ -200,11 +202,8 @@ namespace level
                 // visual size for thrower block
                 b2Vec2 extentPx = {32.0f, 32.0f};
 
-                // Load texture for thrower (fallback to box texture)
-                std::string texturePath = parseTexturePath(t, "texture", "box.png");
-                Texture throwerTexture = ctx.textureLoader ? ctx.textureLoader(texturePath) : ctx.boxTexture;
-
-                ctx.throwers.push_back(makeThrowerEntity(ctx.em, ctx.world, ctx.unitsPerMeter, extentPx, posM, power, impulseMult, throwerTexture, ctx.boxPolygon, ctx.boxExtentPx, ctx.boxes));
+                // Thrown projectiles use the level's box texture/polygon (see LogicContext)
+                makeThrowerEntity(ctx.store, ctx.world, ctx.unitsPerMeter, extentPx, posM, power, impulseMult);
             }
         }
 
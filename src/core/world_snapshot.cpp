@@ -0,0 +1,216 @@
+#include "../includes/core/world_snapshot.hpp"
+#include "../includes/entities/factory.hpp"
+
+#include <utility>
+
+void WorldSnapshot::capture(const ComponentStore &store)
+{
+    image.copyFrom(store);
+    bodies.clear();
+    merged.clear();
+    joints.clear();
+
+    // Chains are kept collapsed: drop the link entities from the copy
+    const std::vector<EntityId> links = image.pool<ChainLink>().entities();
+    for (EntityId link : links)
+        image.destroy(link);
+    image.view<ChainContext>().each([](ChainContext &chain)
+                                    {
+                                        chain.links.clear();
+                                        chain.rope = b2_nullJointId; // the live rope is kept on restore
+                                        chain.restTime = 0.0f;
+                                    });
+
+    // Body state of every entity body that can move (static bodies never do)
+    const ComponentPool<PhysicsBody> &physics = store.pool<PhysicsBody>();
+    bodies.reserve(physics.size());
+    for (std::size_t i = 0; i < physics.size(); ++i)
+    {
+        const EntityId id = physics.entity(i);
+        const b2BodyId body = physics.at(i).id;
+        if (store.has<ChainLink>(id) || !b2Body_IsValid(body) || b2Body_GetType(body) == b2_staticBody)
+            continue;
+        bodies.push_back({id, body, b2Body_GetTransform(body), b2Body_GetLinearVelocity(body),
+                          b2Body_GetAngularVelocity(body), b2Body_IsAwake(body), b2Body_IsEnabled(body)});
+    }
+
+    // Merged boxes: the shape on the anchor, and the parked body stays disabled
+    store.view<MergedShape>().each([&](EntityId id, const MergedShape &shape)
+                                   {
+                                       if (B2_IS_NON_NULL(shape.parked) && b2Body_IsValid(shape.parked))
+                                           bodies.push_back({id, shape.parked, b2Body_GetTransform(shape.parked),
+                                                             {0.0f, 0.0f}, 0.0f, false, false});
+                                       if (!b2Shape_IsValid(shape.shape))
+                                           return;
+                                       merged.push_back({id, b2Shape_GetPolygon(shape.shape), b2Shape_GetDensity(shape.shape),
+                                                         b2Shape_GetFriction(shape.shape), b2Shape_GetRestitution(shape.shape),
+                                                         b2Shape_GetFilter(shape.shape)});
+                                   });
+
+    // Impale joints, read back from Box2D
+    store.view<Impaled>().each([&](EntityId id, const Impaled &impaled)
+                               {
+                                   if (!impaled.hasJoint() || !b2Joint_IsValid(impaled.jointId))
+                                       return;
+                                   const b2JointId joint = impaled.jointId;
+                                   JointRecord record{};
+                                   record.owner = id;
+                                   record.type = b2Joint_GetType(joint);
+                                   record.bodyA = b2Joint_GetBodyA(joint);
+                                   record.bodyB = b2Joint_GetBodyB(joint);
+                                   record.localAnchorA = b2Joint_GetLocalAnchorA(joint);
+                                   record.localAnchorB = b2Joint_GetLocalAnchorB(joint);
+                                   record.collideConnected = b2Joint_GetCollideConnected(joint);
+                                   if (record.type == b2_distanceJoint)
+                                   {
+                                       record.length = b2DistanceJoint_GetLength(joint);
+                                       record.enableLimit = b2DistanceJoint_IsLimitEnabled(joint);
+                                       record.minLength = b2DistanceJoint_GetMinLength(joint);
+                                       record.maxLength = b2DistanceJoint_GetMaxLength(joint);
+                                       record.enableSpring = b2DistanceJoint_IsSpringEnabled(joint);
+                                       record.hertz = b2DistanceJoint_GetSpringHertz(joint);
+                                       record.dampingRatio = b2DistanceJoint_GetSpringDampingRatio(joint);
+                                   }
+                                   joints.push_back(record);
+                               });
+    taken = true;
+}
+
+bool WorldSnapshot::restore(ComponentStore &store, b2WorldId world, float unitsPerMeter) const
+{
+    if (!taken)
+        return false;
+    for (const BodyState &state : bodies)
+    {
+        if (!b2Body_IsValid(state.body))
+            return false;
+    }
+
+    // Tear down what the live world built on top of its bodies
+    store.view<Impaled>().each([](Impaled &impaled)
+                               {
+                                   if (impaled.hasJoint() && b2Joint_IsValid(impaled.jointId))
+                                       b2DestroyJoint(impaled.jointId);
+                                   impaled.jointId = b2_nullJointId;
+                               });
+    store.view<MergedShape>().each([](MergedShape &shape)
+                                   {
+                                       if (b2Shape_IsValid(shape.shape))
+                                           b2DestroyShape(shape.shape, true);
+                                       shape.shape = b2_nullShapeId;
+                                   });
+
+    std::vector<EntityId> &expanded = expandedScratch;
+    expanded.clear();
+    store.view<ChainContext>().each([&](EntityId spike, const ChainContext &chain)
+                                    {
+                                        if (chain.expanded())
+                                            expanded.push_back(spike);
+                                    });
+    for (EntityId spike : expanded)
+        collapseChain(store, world, unitsPerMeter, spike);
+    std::vector<std::pair<EntityId, b2JointId>> &ropes = ropeScratch;
+    ropes.clear();
+    store.view<ChainContext>().each([&](EntityId spike, const ChainContext &chain)
+                                    { ropes.emplace_back(spike, chain.rope); });
+
+    // Bodies: borrowed ones go back to their pool, ones owned by entities the
+    // snapshot does not know are destroyed, all others are reused as they are
+    store.view<PhysicsBody>().each([&](EntityId id, const PhysicsBody &body)
+                                   {
+                                       const PooledBody *pooled = store.tryGet<PooledBody>(id);
+                                       if (pooled && pooled->pool)
+                                           pooled->pool->release(body.id);
+                                       else if (!image.isAlive(id) && b2Body_IsValid(body.id))
+                                           b2DestroyBody(body.id);
+                                   });
+    store.view<MergedShape>().each([&](EntityId id, const MergedShape &shape)
+                                   {
+                                       if (!image.isAlive(id) && B2_IS_NON_NULL(shape.parked) && b2Body_IsValid(shape.parked))
+                                           b2DestroyBody(shape.parked);
+                                   });
+
+    store.copyFrom(image);
+
+    for (const auto &[spike, rope] : ropes)
+    {
+        if (ChainContext *chain = store.tryGet<ChainContext>(spike))
+            chain->rope = rope;
+    }
+    store.view<PhysicsBody, PooledBody>().each([](const PhysicsBody &body, const PooledBody &pooled)
+                                               {
+                                                   if (pooled.pool)
+                                                       pooled.pool->take(body.id);
+                                               });
+
+    // Body state; sleep flags wait until the joints are back
+    for (const BodyState &state : bodies)
+    {
+        if (!state.enabled)
+        {
+            if (b2Body_IsEnabled(state.body))
+                b2Body_Disable(state.body);
+            continue;
+        }
+        if (!b2Body_IsEnabled(state.body))
+            b2Body_Enable(state.body);
+        b2Body_SetTransform(state.body, state.transform.p, state.transform.q);
+        b2Body_SetLinearVelocity(state.body, state.linearVelocity);
+        b2Body_SetAngularVelocity(state.body, state.angularVelocity);
+        PoseCache::retag(state.entity, state.body);
+    }
+
+    for (const MergedRecord &record : merged)
+    {
+        MergedShape &shape = store.get<MergedShape>(record.entity);
+        const PhysicsBody *anchor = store.tryGet<PhysicsBody>(shape.anchor);
+        if (!anchor || !b2Body_IsValid(anchor->id))
+            continue;
+        b2ShapeDef sdef = b2DefaultShapeDef();
+        sdef.density = record.density;
+        sdef.material.friction = record.friction;
+        sdef.material.restitution = record.restitution;
+        sdef.filter = record.filter;
+        sdef.enableSensorEvents = false;
+        shape.shape = b2CreatePolygonShape(anchor->id, &sdef, &record.polygon);
+    }
+
+    for (const JointRecord &record : joints)
+    {
+        Impaled &impaled = store.get<Impaled>(record.owner);
+        if (record.type == b2_distanceJoint)
+        {
+            b2DistanceJointDef def = b2DefaultDistanceJointDef();
+            def.bodyIdA = record.bodyA;
+            def.bodyIdB = record.bodyB;
+            def.localAnchorA = record.localAnchorA;
+            def.localAnchorB = record.localAnchorB;
+            def.collideConnected = record.collideConnected;
+            def.length = record.length;
+            def.enableLimit = record.enableLimit;
+            def.minLength = record.minLength;
+            def.maxLength = record.maxLength;
+            def.enableSpring = record.enableSpring;
+            def.hertz = record.hertz;
+            def.dampingRatio = record.dampingRatio;
+            impaled.jointId = b2CreateDistanceJoint(world, &def);
+        }
+        else
+        {
+            b2RevoluteJointDef def = b2DefaultRevoluteJointDef();
+            def.bodyIdA = record.bodyA;
+            def.bodyIdB = record.bodyB;
+            def.localAnchorA = record.localAnchorA;
+            def.localAnchorB = record.localAnchorB;
+            def.collideConnected = record.collideConnected;
+            impaled.jointId = b2CreateRevoluteJoint(world, &def);
+        }
+    }
+
+    for (const BodyState &state : bodies)
+    {
+        if (state.enabled)
+            b2Body_SetAwake(state.body, state.awake);
+    }
+    return true;
+}
@@ -0,0 +1,341 @@
+// Headless batch runner: sweeps level tunings over many independent worlds.
+//
+// Each run loads the level into its own Simulation (own b2WorldId, entity
+// store and command buffer), applies tunings sampled from the ranges given on
+// the command line, fires scripted throws and simulates a fixed number of
+// seconds. Runs are spread over a JobSystem, one world per job, and every run
+// is seeded from --seed plus its index, so results do not depend on the thread
+// count. No window or GL context is created; one CSV line per run goes to stdout.
+// With --replay, a recorded input trace (IMPALE_RECORD) is played back
+// through one Simulation instead and its checksums are compared.
+//
+// Usage: the-impale-batch [options] [level.toml]   (default: levels/demo.toml)
+//        the-impale-batch --replay trace.bin
+
+#include "raylib.h"
+#include "box2d/box2d.h"
+
+#include "../includes/core/simulation.hpp"
+#include "../includes/core/job_system.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    struct Range
+    {
+        float min{0.0f};
+        float max{0.0f};
+        bool set{false};
+
+        float sample(std::mt19937 &rng) const
+        {
+            if (max <= min)
+                return min;
+            return std::uniform_real_distribution<float>(min, max)(rng);
+        }
+    };
+
+    struct BatchOptions
+    {
+        std::string level{"levels/demo.toml"};
+        int runs{64};
+        float seconds{20.0f};
+        unsigned threads{0}; // 0 = all hardware threads
+        uint32_t seed{1};
+        Range power;                        // thrower maxPower (default: level value)
+        Range impulse;                      // impulseMultiplier (default: level value)
+        float spikeJitter{0.0f};            // max spike offset per axis (pixels)
+        float interval{1.0f};               // seconds between throws
+        Range angle{-60.0f, -10.0f, true};  // throw angle, degrees (0 = right, -90 = up)
+        Range charge{0.5f, 1.0f, true};     // fraction of maxPower
+        std::string replay;                 // input trace to play back instead of a sweep
+    };
+
+    struct RunResult
+    {
+        float power{0.0f};
+        float impulse{0.0f};
+        int throws{0};
+        uint32_t captures{0};
+        std::size_t impaled{0}; // boxes attached at the end (jointed or merged)
+        uint64_t ticks{0};
+        double wallMs{0.0};
+        bool ok{false};
+    };
+
+    void PrintUsage()
+    {
+        std::fprintf(stderr,
+                     "Usage: the-impale-batch [options] [level.toml]\n"
+                     "  --runs N           simulations to run (default 64)\n"
+                     "  --seconds S        simulated seconds per run (default 20)\n"
+                     "  --threads N        threads, 0 = all hardware threads (default 0)\n"
+                     "  --seed N           base seed, run i uses seed + i (default 1)\n"
+                     "  --power A[:B]      thrower max power range (default: level value)\n"
+                     "  --impulse A[:B]    impulse multiplier range (default: level value)\n"
+                     "  --spike-jitter PX  random spike offset per axis (default 0)\n"
+                     "  --interval S       seconds between throws (default 1)\n"
+                     "  --angle A:B        throw angle range, degrees, -90 = up (default -60:-10)\n"
+                     "  --charge A:B       charge as a fraction of max power (default 0.5:1)\n"
+                     "  --replay FILE      play back an input trace recorded with IMPALE_RECORD\n");
+    }
+
+    bool ParseRange(const char *text, Range &range)
+    {
+        char *end = nullptr;
+        range.min = std::strtof(text, &end);
+        if (end == text)
+            return false;
+        range.max = (*end == ':') ? std::strtof(end + 1, nullptr) : range.min;
+        range.set = true;
+        return true;
+    }
+
+    bool ParseArgs(int argc, char **argv, BatchOptions &options)
+    {
+        for (int i = 1; i < argc; ++i)
+        {
+            const char *arg = argv[i];
+            const char *value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+            auto takes = [&](const char *name)
+            {
+                if (std::strcmp(arg, name) != 0)
+                    return false;
+                if (!value)
+                {
+                    std::fprintf(stderr, "%s needs a value\n", name);
+                    std::exit(2);
+                }
+                ++i;
+                return true;
+            };
+
+            if (takes("--runs"))
+                options.runs = std::atoi(value);
+            else if (takes("--seconds"))
+                options.seconds = std::strtof(value, nullptr);
+            else if (takes("--threads"))
+                options.threads = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+            else if (takes("--seed"))
+                options.seed = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+            else if (takes("--power"))
+            {
+                if (!ParseRange(value, options.power))
+                    return false;
+            }
+            else if (takes("--impulse"))
+            {
+                if (!ParseRange(value, options.impulse))
+                    return false;
+            }
+            else if (takes("--spike-jitter"))
+                options.spikeJitter = std::strtof(value, nullptr);
+            else if (takes("--interval"))
+                options.interval = std::strtof(value, nullptr);
+            else if (takes("--angle"))
+            {
+                if (!ParseRange(value, options.angle))
+                    return false;
+            }
+            else if (takes("--charge"))
+            {
+                if (!ParseRange(value, options.charge))
+                    return false;
+            }
+            else if (takes("--replay"))
+                options.replay = value;
+            else if (arg[0] == '-')
+                return false;
+            else
+                options.level = arg;
+        }
+        return options.runs > 0 && options.seconds > 0.0f && options.interval > 0.0f;
+    }
+
+    // Move a spike (and its chain hook) by an offset before the first tick
+    void OffsetSpike(Simulation &sim, EntityId spike, b2Vec2 offsetPx)
+    {
+        ComponentStore &store = sim.components();
+        const float invUnits = 1.0f / sim.config().unitsPerMeter;
+        auto shift = [&](EntityId id)
+        {
+            const b2BodyId body = store.get<PhysicsBody>(id).id;
+            b2Vec2 p = b2Body_GetPosition(body);
+            p.x += offsetPx.x * invUnits;
+            p.y += offsetPx.y * invUnits;
+            b2Body_SetTransform(body, p, b2Body_GetRotation(body));
+            store.pool<BodyPose>().sync(id, body);
+        };
+        shift(spike);
+        if (const ChainContext *chain = store.tryGet<ChainContext>(spike))
+            shift(chain->hook);
+    }
+
+    RunResult RunOne(const BatchOptions &options, const SimulationConfig &config, int index)
+    {
+        RunResult result;
+        const auto start = std::chrono::steady_clock::now();
+        std::mt19937 rng(options.seed + static_cast<uint32_t>(index));
+
+        Simulation sim{config};
+        if (!sim.loadLevel(options.level))
+            return result;
+        ComponentStore &store = sim.components();
+
+        // Tunings
+        const EntityId throwerId = sim.thrower();
+        ThrowerContext *thrower = throwerId ? store.tryGet<ThrowerContext>(throwerId) : nullptr;
+        if (thrower)
+        {
+            if (options.power.set)
+                thrower->maxPower = options.power.sample(rng);
+            if (options.impulse.set)
+                thrower->impulseMultiplier = options.impulse.sample(rng);
+            result.power = thrower->maxPower;
+            result.impulse = thrower->impulseMultiplier;
+        }
+        if (options.spikeJitter > 0.0f)
+        {
+            std::uniform_real_distribution<float> jitter(-options.spikeJitter, options.spikeJitter);
+            const std::vector<EntityId> spikes = store.pool<SpikeProperties>().entities();
+            for (EntityId spike : spikes)
+            {
+                const float dx = jitter(rng);
+                const float dy = jitter(rng);
+                OffsetSpike(sim, spike, {dx, dy});
+            }
+        }
+
+        // Scripted throws every `interval` seconds, first one on tick 0
+        const uint64_t totalTicks = static_cast<uint64_t>(std::lround(options.seconds * config.hz));
+        const uint64_t throwEvery = std::max<uint64_t>(1, static_cast<uint64_t>(std::lround(options.interval * config.hz)));
+        for (uint64_t tick = 0; tick < totalTicks; ++tick)
+        {
+            if (thrower && tick % throwEvery == 0)
+            {
+                const float radians = DEG2RAD * options.angle.sample(rng);
+                const float charge = options.charge.sample(rng) * thrower->maxPower;
+                if (sim.throwProjectile({cosf(radians), sinf(radians)}, charge))
+                    ++result.throws;
+            }
+            sim.tick();
+        }
+
+        result.captures = sim.logic().captures;
+        store.view<Impaled>().each([&](EntityId, const Impaled &impaled)
+                                   { result.impaled += impaled.frozen ? 1 : 0; });
+        result.ticks = sim.tickCount();
+        result.wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        result.ok = true;
+        return result;
+    }
+
+    // Play an input trace back headless: same level, rate and per-tick input as
+    // the recorded session. Exit status 1 if the world diverged from it.
+    int RunReplay(const std::string &path, SimulationConfig config)
+    {
+        InputTrace trace;
+        if (!trace.load(path))
+        {
+            std::fprintf(stderr, "Cannot read input trace %s\n", path.c_str());
+            return 2;
+        }
+        config.hz = trace.hz;
+        config.subSteps = trace.subSteps;
+        Simulation sim{config};
+        if (!sim.loadLevel(trace.level))
+        {
+            std::fprintf(stderr, "Cannot load level %s\n", trace.level.c_str());
+            return 2;
+        }
+
+        std::size_t divergedAt = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t tick = 0; tick < trace.size(); ++tick)
+        {
+            sim.apply(trace.at(tick));
+            sim.tick();
+            if (divergedAt == 0 && !trace.verify(tick + 1, sim.components()))
+                divergedAt = tick + 1;
+        }
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        std::printf("ticks,wall_ms,ticks_per_s,diverged_at\n%zu,%.2f,%.0f,%zu\n", trace.size(), ms,
+                    trace.size() / (ms / 1000.0), divergedAt);
+        if (divergedAt)
+            std::fprintf(stderr, "Replay diverged from the recording by tick %zu\n", divergedAt);
+        return divergedAt == 0 ? 0 : 1;
+    }
+
+    // Half extents of an image file (CPU decode only, no GL); fallback if missing
+    b2Vec2 ImageHalfExtent(const char *path, b2Vec2 fallback)
+    {
+        Image image = LoadImage(path);
+        if (!image.data)
+            return fallback;
+        b2Vec2 extent = {0.5f * image.width, 0.5f * image.height};
+        UnloadImage(image);
+        return extent;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    BatchOptions options;
+    if (!ParseArgs(argc, argv, options))
+    {
+        PrintUsage();
+        return 2;
+    }
+    SetTraceLogLevel(LOG_WARNING);
+
+    // Same scale and sizes as the windowed game (sizes come from its textures)
+    SimulationConfig config;
+    b2SetLengthUnitsPerMeter(config.unitsPerMeter);
+    config.groundExtentPx = ImageHalfExtent("ground.png", config.groundExtentPx);
+    config.boxExtentPx = ImageHalfExtent("block.png", config.boxExtentPx);
+    if (!options.replay.empty())
+        return RunReplay(options.replay, config);
+
+    // One world per job; the calling thread works too
+    const unsigned threads = options.threads > 0 ? options.threads : JobSystem::DefaultWorkerCount() + 1;
+    JobSystem jobs{threads - 1};
+    std::vector<RunResult> results(static_cast<std::size_t>(options.runs));
+
+    const auto start = std::chrono::steady_clock::now();
+    jobs.parallelFor(static_cast<uint32_t>(options.runs), 1, [&](uint32_t begin, uint32_t end, uint32_t)
+                     {
+                         for (uint32_t i = begin; i < end; ++i)
+                             results[i] = RunOne(options, config, static_cast<int>(i));
+                     });
+    const double totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::printf("run,seed,power,impulse,throws,captures,impaled,ticks,wall_ms\n");
+    int failed = 0;
+    uint64_t ticks = 0;
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        const RunResult &r = results[i];
+        if (!r.ok)
+        {
+            ++failed;
+            continue;
+        }
+        ticks += r.ticks;
+        std::printf("%zu,%u,%.3f,%.3f,%d,%u,%zu,%llu,%.2f\n", i, options.seed + static_cast<uint32_t>(i),
+                    r.power, r.impulse, r.throws, r.captures, r.impaled,
+                    static_cast<unsigned long long>(r.ticks), r.wallMs);
+    }
+    std::fprintf(stderr, "%d runs (%d failed) on %u threads in %.1f s, %.0f ticks/s\n",
+                 options.runs, failed, threads, totalMs / 1000.0, ticks / (totalMs / 1000.0));
+    return failed == 0 ? 0 : 1;
+}
@@ -41,6 +41,8 @@ struct Advertisement
 
     // Visual
     Texture2D texture = {0};         // Textura carregada
+    Rectangle textureRect = {0, 0, 0, 0}; // Região usada da textura (vazia = textura inteira)
+    bool atlasTexture = false;       // Textura é uma página do atlas (não descarregar)
     Rectangle bounds = {0, 0, 0, 0}; // Posição e tamanho na tela
     float rotation = 0.0f;           // Rotação em graus
     Color tint = WHITE;              // Cor de tinta
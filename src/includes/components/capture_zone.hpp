@@ -0,0 +1,9 @@
+#pragma once
+
+// On a spike (or chain hook) carrying a capture sensor: the sensor circle's
+// radius in pixels. Lets the swept capture test (UpdateCapture) reproduce the
+// sensor for boxes that crossed it between two steps.
+struct CaptureZone
+{
+    float radius{0.0f}; // pixels, centered on the body
+};
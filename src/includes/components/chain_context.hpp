@@ -0,0 +1,37 @@
+#pragma once
+#include "box2d/box2d.h"
+#include "../core/entity_manager.hpp"
+
+#include <vector>
+
+// Chain spike state: the hook hanging from the spike.
+// Stored in its own component pool, so the capture loop and renderer read it
+// packed by entity instead of through a heap pointer per spike.
+// The hook hangs either on a single rope joint (collapsed, the default) or on
+// a chain of link bodies (expanded); the chain LOD system switches between them.
+struct ChainContext
+{
+    b2BodyId hookBody{b2_nullBodyId};
+    float halfW{0.0f}; // hook base half extents (pixels, before hookScaleW/H)
+    float halfH{0.0f};
+    EntityId hook{};   // hook entity (pose cache key)
+
+    b2JointId rope{b2_nullJointId}; // spike -> hook distance joint while collapsed
+    std::vector<EntityId> links;    // link entities spike -> hook while expanded
+    float restTime{0.0f};           // seconds the expanded chain has been at rest
+
+    bool expanded() const { return !links.empty(); }
+};
+
+// On a chain link entity: the chain spike that owns it
+struct ChainLink
+{
+    EntityId spike{};
+};
+
+// On the hook entity: back reference to the chain spike that owns it, so a
+// sensor event on the hook resolves to the spike's capture settings.
+struct ChainHook
+{
+    EntityId spike{};
+};
@@ -0,0 +1,12 @@
+#pragma once
+#include "../core/entity_manager.hpp"
+
+#include <vector>
+
+// On a spike (or chain hook): boxes captured by it that still hang from their
+// own joint, oldest first. The consolidation system merges them into the
+// anchor's body once they settle or when the spike's joint budget is exceeded.
+struct ImpaleCluster
+{
+    std::vector<EntityId> boxes;
+};
@@ -1,10 +1,12 @@
 #pragma once
 #include "box2d/box2d.h"
+#include "../core/entity_manager.hpp"
 
 // Component marking entities that have been impaled/attached to spikes
 struct Impaled
 {
     bool frozen{false};
     b2JointId jointId{b2_nullJointId}; // Joint connecting box to spike (for chain/pendulum physics)
+    EntityId anchor{};                 // spike (or chain hook) the box is attached to
     bool hasJoint() const { return B2_IS_NON_NULL(jointId); }
 };
@@ -0,0 +1,8 @@
+#pragma once
+
+// Lifetime component: marks entities the lifetime system may despawn (thrown projectiles)
+struct Lifetime
+{
+    float age{0.0f};         // seconds since spawn
+    float settledTime{0.0f}; // seconds spent impaled and asleep
+};
@@ -0,0 +1,15 @@
+#pragma once
+#include "box2d/box2d.h"
+#include "../core/entity_manager.hpp"
+
+// A box consolidated into its spike's body: its joint is gone, its own body is
+// out of the simulation and its collision shape lives on the anchor's body.
+// The pose cache entry is derived from the anchor's pose and this fixed local offset.
+struct MergedShape
+{
+    EntityId anchor{};               // spike or chain hook entity owning the shape
+    b2ShapeId shape{b2_nullShapeId}; // box shape on the anchor's body
+    b2Vec2 offset{0.0f, 0.0f};       // position in the anchor's frame (pixels)
+    b2Rot rotation{1.0f, 0.0f};      // rotation relative to the anchor
+    b2BodyId parked{b2_nullBodyId};  // the box's own body, disabled (null if it went back to a BodyPool)
+};
@@ -0,0 +1,9 @@
+#pragma once
+
+class BodyPool;
+
+// Marks an entity whose body is borrowed from a BodyPool; it is released back instead of destroyed
+struct PooledBody
+{
+    BodyPool *pool{nullptr};
+};
@@ -0,0 +1,9 @@
+#pragma once
+
+// Visual spin of a saw blade, advanced by SpikeUpdate and read by SpikeRender.
+// Kept apart from SpikeProperties so spinning saws never blocks systems that
+// only read the spike configuration (e.g. the capture check).
+struct SawRotation
+{
+    float degrees{0.0f}; // current rotation angle
+};
@@ -1,19 +1,19 @@
 #pragma once
+#include "../core/entity_manager.hpp"
 
-// Forward declaration to avoid circular include between Script and GameEntity
-struct GameEntity;
+// Forward declarations to avoid circular includes between Script, ComponentStore and the renderer
+class ComponentStore;
+class SpriteBatch;
 
 // Script component: function hooks for per-entity logic and rendering
 // - update runs outside the render phase
-// - render runs inside the render phase
+// - render runs inside the render phase and submits quads to the frame's SpriteBatch
 struct Script
 {
-    using UpdateFn = void (*)(GameEntity &e, float dt);
-    using RenderFn = void (*)(const GameEntity &e, float unitsPerMeter);
-    using FreeFn = void (*)(void *);
+    using UpdateFn = void (*)(ComponentStore &store, EntityId id, float dt);
+    using RenderFn = void (*)(const ComponentStore &store, EntityId id, float unitsPerMeter, SpriteBatch &batch);
 
     UpdateFn update{nullptr};
     RenderFn render{nullptr};
-    void *user{nullptr};    // optional user context
-    FreeFn freeFn{nullptr}; // optional deleter for user context
+    // Per-script state is a typed component of the same entity (ChainContext, ThrowerContext)
 };
@@ -13,8 +13,8 @@ struct SpikeProperties
 {
     SpikeType type{SpikeType::NORMAL};
     float rotationSpeed{0.0f};   // for SAW type (degrees per second)
+    int teeth{8};                // for SAW type
     float chainLength{0.0f};     // for CHAIN type (pixels)
-    float currentRotation{0.0f}; // current rotation angle
 
     // Chain tuning (for CHAIN type)
     float linkLengthPx{20.0f};    // rectangular link length in pixels
@@ -27,4 +27,8 @@ struct SpikeProperties
     float jointHertz{3.0f};       // spring freq for attach (distance joint)
     float jointDamping{0.5f};     // damping ratio for attach (distance joint)
     bool chainSelfCollide{false}; // whether links collide with each other and spike
+
+    // Consolidation: captured boxes hanging from their own joint before the
+    // oldest are merged into the spike's body (0 = unlimited)
+    int jointBudget{8};
 };
@@ -1,8 +1,21 @@
 #pragma once
 #include "raylib.h"
 
-// Sprite component: holds texture to render
+// Sprite component: the texture to render and the part of it holding the image
+// (the whole texture, or the image's rectangle on an atlas page).
+// Converts from a plain Texture, which covers all of it.
 struct Sprite
 {
-    Texture texture;
+    Texture texture{};
+    Rectangle source{0, 0, 0, 0}; // texels
+
+    Sprite() = default;
+    Sprite(const Texture &whole)
+        : texture(whole), source{0, 0, (float)whole.width, (float)whole.height} {}
+    Sprite(const Texture &page, Rectangle region)
+        : texture(page), source(region) {}
+
+    // Size of the image in pixels
+    float width() const { return source.width; }
+    float height() const { return source.height; }
 };
@@ -0,0 +1,15 @@
+#pragma once
+
+// Category tags: empty components marking what kind of entity it is.
+// Spikes are identified by SpikeProperties, so they carry no tag.
+struct BoxTag
+{
+};
+
+struct ObstacleTag
+{
+};
+
+struct ThrowerTag
+{
+};
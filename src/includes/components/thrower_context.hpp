@@ -0,0 +1,14 @@
+#pragma once
+#include "raylib.h"
+
+// Thrower state: aim and charge. Projectile body, texture and pool come from
+// LogicContext when firing.
+struct ThrowerContext
+{
+    float maxPower{300.0f};
+    float chargeRate{150.0f}; // power increase per second
+    float currentCharge{0.0f};
+    bool isCharging{false};
+    Vector2 aimDir{1.0f, 0.0f}; // normalized aim direction
+    float impulseMultiplier{8.0f};
+};
@@ -0,0 +1,103 @@
+#pragma once
+#include "box2d/box2d.h"
+#include "raylib.h"
+
+#include "../components/physics_material.hpp"
+
+#include <vector>
+
+// Pool of identical, pre-created Box2D bodies. Bodies are built disabled when a
+// level loads; acquire() teleports and enables one, release() disables it again,
+// so spawning never calls b2CreateBody/b2CreatePolygonShape mid-frame.
+class BodyPool
+{
+public:
+    void build(b2WorldId world, const b2Polygon &polygon, const PhysicsMaterial &mat, std::size_t count)
+    {
+        this->world = world;
+        this->polygon = polygon;
+        this->material = mat;
+        freeBodies.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+            freeBodies.push_back(createBody());
+        capacity = count;
+    }
+
+    // Enable a pooled body at the given position with zero velocity
+    b2BodyId acquire(b2Vec2 posMeters)
+    {
+        b2BodyId body;
+        if (freeBodies.empty())
+        {
+            // Exhausted: grow rather than drop the spawn (the despawn cap normally prevents this)
+            TraceLog(LOG_WARNING, "BodyPool exhausted (%zu bodies), creating one mid-frame", capacity);
+            body = createBody();
+            ++capacity;
+        }
+        else
+        {
+            body = freeBodies.back();
+            freeBodies.pop_back();
+        }
+        b2Body_SetTransform(body, posMeters, b2Rot_identity);
+        b2Body_SetLinearVelocity(body, {0.0f, 0.0f});
+        b2Body_SetAngularVelocity(body, 0.0f);
+        b2Body_Enable(body);
+        return body;
+    }
+
+    // Return a body to the pool; it leaves the simulation until acquired again
+    void release(b2BodyId body)
+    {
+        if (!b2Body_IsValid(body))
+            return;
+        b2Body_Disable(body);
+        b2Body_SetUserData(body, nullptr);
+        freeBodies.push_back(body);
+    }
+
+    // Take a specific free body back out of the pool and enable it, leaving
+    // its transform alone (snapshot restore). False if it is not free.
+    bool take(b2BodyId body)
+    {
+        for (std::size_t i = 0; i < freeBodies.size(); ++i)
+        {
+            if (B2_ID_EQUALS(freeBodies[i], body))
+            {
+                freeBodies.erase(freeBodies.begin() + static_cast<std::ptrdiff_t>(i));
+                b2Body_Enable(body);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::size_t available() const { return freeBodies.size(); }
+    std::size_t size() const { return capacity; }
+
+private:
+    b2BodyId createBody() const
+    {
+        b2BodyDef def = b2DefaultBodyDef();
+        def.type = b2_dynamicBody;
+        def.linearDamping = material.linearDamping;
+        def.angularDamping = material.angularDamping;
+        def.gravityScale = material.affectedByGravity ? 1.0f : 0.0f;
+        def.isEnabled = false;
+        b2BodyId body = b2CreateBody(world, &def);
+
+        b2ShapeDef sdef = b2DefaultShapeDef();
+        sdef.density = material.density;
+        sdef.material.friction = material.friction;
+        sdef.material.restitution = material.restitution;
+        sdef.enableSensorEvents = true; // projectiles are boxes: visible to spike sensors
+        b2CreatePolygonShape(body, &sdef, &polygon);
+        return body;
+    }
+
+    b2WorldId world{b2_nullWorldId};
+    b2Polygon polygon{};
+    PhysicsMaterial material{};
+    std::vector<b2BodyId> freeBodies;
+    std::size_t capacity{0};
+};
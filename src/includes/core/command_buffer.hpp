@@ -0,0 +1,151 @@
+#pragma once
+#include "box2d/box2d.h"
+
+#include "component_store.hpp"
+#include "pose_cache.hpp"
+#include "body_pool.hpp"
+#include "../components/impaled.hpp"
+#include "../components/physics_body.hpp"
+#include "../components/sprite.hpp"
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+// A thrown box: taken from `pool` at the sync point, then pushed by `impulse`
+// (applied at `pos`, meters). Plain data, so recording a throw never allocates.
+struct ProjectileSpawn
+{
+    BodyPool *pool;
+    Sprite sprite;
+    b2Vec2 extent; // pixels
+    b2Vec2 pos;    // meters
+    b2Vec2 impulse;
+};
+
+// Per-frame buffer of structural world changes (spawn, destroy, joints, components).
+// Systems record commands while iterating; flush() applies them at a single sync
+// point after the physics step, so no container or Box2D world is modified while
+// another system walks it.
+//
+// Flush order: destroy joint -> destroy -> consolidate -> spawn -> add/remove component
+// (and teleports) -> create joint. Projectile spawns go before generic spawns.
+// Destroys and merges run first so pooled bodies are free again before spawns
+// reuse them; commands aimed at entities that died earlier in the flush are skipped.
+class CommandBuffer
+{
+public:
+    using SpawnFn = std::function<void(ComponentStore &store)>;
+    using ComponentFn = std::function<void(ComponentStore &store)>;
+
+    CommandBuffer() { projectiles.reserve(64); }
+
+    // Build a new entity at the sync point
+    void spawn(SpawnFn fn) { spawns.push_back(std::move(fn)); }
+
+    // Fire a pooled projectile at the sync point (the per-throw hot path)
+    void spawn(const ProjectileSpawn &projectile) { projectiles.push_back(projectile); }
+
+    // Destroy an entity (joints, script context, body and id) at the sync point
+    void destroy(EntityId id) { destroys.push_back(id); }
+
+    // Create a joint; its id is stored in owner's Impaled::jointId
+    void createJoint(EntityId owner, const b2RevoluteJointDef &def)
+    {
+        JointCommand cmd;
+        cmd.owner = owner;
+        cmd.kind = JointCommand::Revolute;
+        cmd.revolute = def;
+        jointCreates.push_back(cmd);
+    }
+
+    void createJoint(EntityId owner, const b2DistanceJointDef &def)
+    {
+        JointCommand cmd;
+        cmd.owner = owner;
+        cmd.kind = JointCommand::Distance;
+        cmd.distance = def;
+        jointCreates.push_back(cmd);
+    }
+
+    // Destroy the joint held in owner's Impaled::jointId
+    void destroyJoint(EntityId owner) { jointDestroys.push_back(owner); }
+
+    // Merge an impaled box into its anchor's body (see consolidateEntity)
+    void consolidate(EntityId id) { merges.push_back(id); }
+
+    // Move an entity's body (rotation and velocity kept) and resync its cached pose
+    void teleport(EntityId id, b2Vec2 posMeters)
+    {
+        componentOps.push_back([id, posMeters](ComponentStore &store)
+                               {
+                                   const PhysicsBody *body = store.tryGet<PhysicsBody>(id);
+                                   if (!body || !b2Body_IsValid(body->id))
+                                       return;
+                                   b2Body_SetTransform(body->id, posMeters, b2Body_GetRotation(body->id));
+                                   store.pool<BodyPose>().sync(id, body->id);
+                               });
+    }
+
+    template <typename T>
+    void add(EntityId id, T value)
+    {
+        componentOps.push_back([id, value](ComponentStore &store)
+                               {
+                                   if (store.isAlive(id))
+                                       store.add<T>(id, value);
+                               });
+    }
+
+    template <typename T>
+    void remove(EntityId id)
+    {
+        componentOps.push_back([id](ComponentStore &store)
+                               { store.remove<T>(id); });
+    }
+
+    bool empty() const
+    {
+        return spawns.empty() && projectiles.empty() && destroys.empty() && jointCreates.empty() &&
+               jointDestroys.empty() && componentOps.empty() && merges.empty();
+    }
+
+    // Apply everything recorded since the last flush. Buffers keep their capacity.
+    // Defined in command_buffer.cpp, next to the entity factory it calls into.
+    void flush(ComponentStore &store, b2WorldId world);
+
+    // Drop everything recorded (e.g. before a snapshot restore replaces the world)
+    void clear()
+    {
+        spawns.clear();
+        projectiles.clear();
+        componentOps.clear();
+        jointCreates.clear();
+        jointDestroys.clear();
+        destroys.clear();
+        merges.clear();
+    }
+
+private:
+    struct JointCommand
+    {
+        enum Kind
+        {
+            Revolute,
+            Distance
+        };
+
+        EntityId owner;
+        Kind kind{Revolute};
+        b2RevoluteJointDef revolute{};
+        b2DistanceJointDef distance{};
+    };
+
+    std::vector<SpawnFn> spawns;
+    std::vector<ProjectileSpawn> projectiles;
+    std::vector<ComponentFn> componentOps;
+    std::vector<JointCommand> jointCreates;
+    std::vector<EntityId> jointDestroys;
+    std::vector<EntityId> destroys;
+    std::vector<EntityId> merges;
+};
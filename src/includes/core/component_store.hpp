@@ -0,0 +1,362 @@
+#pragma once
+#include "entity_manager.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Type-erased pool interface so the store can drop every component of an entity
+// (and copy whole pools, see ComponentStore::copyFrom)
+class IComponentPool
+{
+public:
+    virtual ~IComponentPool() = default;
+    virtual bool has(EntityId id) const = 0;
+    virtual void remove(EntityId id) = 0;
+    virtual void clear() = 0;
+    virtual std::size_t size() const = 0;
+    virtual std::unique_ptr<IComponentPool> clone() const = 0;
+    // Become a copy of `other` (same component type), keeping this pool's capacity
+    virtual void copyFrom(const IComponentPool &other) = 0;
+};
+
+// Sparse-set storage for one component type:
+// sparse maps EntityId::index -> dense slot, and dense slots keep the owning
+// entity and its component packed contiguously for linear iteration.
+template <typename T>
+class ComponentPool final : public IComponentPool
+{
+public:
+    static constexpr uint32_t npos = 0xFFFFFFFFu;
+
+    void reserve(std::size_t count)
+    {
+        dense.reserve(count);
+        components.reserve(count);
+    }
+
+    // Insert or overwrite the component for an entity
+    T &add(EntityId id, T value)
+    {
+        if (id.index >= sparse.size())
+            sparse.resize(id.index + 1, npos);
+
+        uint32_t &slot = sparse[id.index];
+        if (slot != npos)
+        {
+            // Same index: either the same entity or a stale generation, reuse the slot
+            dense[slot] = id;
+            components[slot] = std::move(value);
+            return components[slot];
+        }
+
+        slot = static_cast<uint32_t>(dense.size());
+        dense.push_back(id);
+        components.push_back(std::move(value));
+        return components.back();
+    }
+
+    // Swap-remove: the last component moves into the freed slot
+    void remove(EntityId id) override
+    {
+        if (!has(id))
+            return;
+        uint32_t slot = sparse[id.index];
+        uint32_t last = static_cast<uint32_t>(dense.size() - 1);
+        if (slot != last)
+        {
+            dense[slot] = dense[last];
+            components[slot] = std::move(components[last]);
+            sparse[dense[slot].index] = slot;
+        }
+        dense.pop_back();
+        components.pop_back();
+        sparse[id.index] = npos;
+    }
+
+    bool has(EntityId id) const override
+    {
+        return id.index < sparse.size() && sparse[id.index] != npos && dense[sparse[id.index]] == id;
+    }
+
+    T *tryGet(EntityId id) { return has(id) ? &components[sparse[id.index]] : nullptr; }
+    const T *tryGet(EntityId id) const { return has(id) ? &components[sparse[id.index]] : nullptr; }
+
+    // Unchecked access: caller guarantees has(id)
+    T &get(EntityId id) { return components[sparse[id.index]]; }
+    const T &get(EntityId id) const { return components[sparse[id.index]]; }
+
+    void clear() override
+    {
+        sparse.clear();
+        dense.clear();
+        components.clear();
+    }
+
+    std::size_t size() const override { return dense.size(); }
+    bool empty() const { return dense.empty(); }
+
+    std::unique_ptr<IComponentPool> clone() const override { return std::make_unique<ComponentPool<T>>(*this); }
+    void copyFrom(const IComponentPool &other) override { *this = static_cast<const ComponentPool<T> &>(other); }
+
+    // Dense access for tight loops: entity(i) owns at(i)
+    EntityId entity(std::size_t i) const { return dense[i]; }
+    T &at(std::size_t i) { return components[i]; }
+    const T &at(std::size_t i) const { return components[i]; }
+
+    const std::vector<EntityId> &entities() const { return dense; }
+    std::vector<T> &data() { return components; }
+    const std::vector<T> &data() const { return components; }
+
+private:
+    std::vector<uint32_t> sparse; // entity index -> dense slot (npos if absent)
+    std::vector<EntityId> dense;  // owning entity per dense slot
+    std::vector<T> components;    // packed component data, parallel to dense
+};
+
+// Storage backing a component type. Specialize to swap in a custom layout
+// (see BodyPose in pose_cache.hpp, which is stored as structure-of-arrays).
+template <typename T>
+struct ComponentStorage
+{
+    using type = ComponentPool<T>;
+};
+
+template <typename T>
+using StorageOf = typename ComponentStorage<T>::type;
+
+// Compile-time query over the entities that own every component in Ts.
+// A const component type is read-only inside the view (View<Impaled, const BodyPose>).
+// each() drives iteration from the smallest pool and probes the others; a
+// single-component view walks its dense array directly. Structural changes
+// (spawn/destroy/add/remove) must go through the CommandBuffer while iterating.
+template <typename... Ts>
+class View
+{
+    static_assert(sizeof...(Ts) > 0, "View needs at least one component type");
+
+    template <typename T>
+    using PoolPtr = std::conditional_t<std::is_const_v<T>,
+                                       const StorageOf<std::remove_const_t<T>> *,
+                                       StorageOf<T> *>;
+
+public:
+    explicit View(PoolPtr<Ts>... pools) : pools(pools...) {}
+
+    bool contains(EntityId id) const
+    {
+        return (pool<Ts>()->has(id) && ...);
+    }
+
+    // Upper bound on the number of matches (size of the smallest pool)
+    std::size_t sizeHint() const { return driver().size(); }
+
+    // Calls fn(id, components...) or fn(components...) for every match
+    template <typename Fn>
+    void each(Fn &&fn) const
+    {
+        if constexpr (sizeof...(Ts) == 1)
+        {
+            auto *p = std::get<0>(pools);
+            const std::size_t n = p->size();
+            for (std::size_t i = 0; i < n; ++i)
+                invoke(fn, p->entity(i), p->at(i));
+        }
+        else
+        {
+            const std::vector<EntityId> &ids = driver();
+            const std::size_t n = ids.size();
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                const EntityId id = ids[i];
+                if (contains(id))
+                    invoke(fn, id, pool<Ts>()->get(id)...);
+            }
+        }
+    }
+
+private:
+    template <typename T>
+    PoolPtr<T> pool() const { return std::get<PoolPtr<T>>(pools); }
+
+    // Entity list of the smallest pool
+    const std::vector<EntityId> &driver() const
+    {
+        const std::vector<EntityId> *best = nullptr;
+        ((best = (!best || pool<Ts>()->size() < best->size()) ? &pool<Ts>()->entities() : best), ...);
+        return *best;
+    }
+
+    template <typename Fn, typename... Args>
+    static void invoke(Fn &fn, EntityId id, Args &&...args)
+    {
+        if constexpr (std::is_invocable_v<Fn &, EntityId, Args...>)
+            fn(id, std::forward<Args>(args)...);
+        else
+            fn(std::forward<Args>(args)...);
+    }
+
+    std::tuple<PoolPtr<Ts>...> pools;
+};
+
+// Owns one pool per component type, keyed by EntityId from the EntityManager
+class ComponentStore
+{
+public:
+    explicit ComponentStore(EntityManager &em) : em(em) {}
+
+    ComponentStore(const ComponentStore &) = delete;
+    ComponentStore &operator=(const ComponentStore &) = delete;
+
+    EntityId create() { return em.create(); }
+
+    // Remove every component of the entity, then recycle its id
+    void destroy(EntityId id)
+    {
+        if (!em.isAlive(id))
+            return;
+        for (auto &p : pools)
+        {
+            if (p)
+                p->remove(id);
+        }
+        em.destroy(id);
+    }
+
+    bool isAlive(EntityId id) const { return em.isAlive(id); }
+
+    template <typename T>
+    decltype(auto) add(EntityId id, T value = T{})
+    {
+        return pool<T>().add(id, std::move(value));
+    }
+
+    template <typename T>
+    void remove(EntityId id)
+    {
+        pool<T>().remove(id);
+    }
+
+    template <typename T>
+    bool has(EntityId id) const
+    {
+        return pool<T>().has(id);
+    }
+
+    // Unchecked access: caller guarantees has<T>(id)
+    template <typename T>
+    decltype(auto) get(EntityId id) { return pool<T>().get(id); }
+
+    template <typename T>
+    decltype(auto) get(EntityId id) const { return pool<T>().get(id); }
+
+    template <typename T>
+    T *tryGet(EntityId id) { return pool<T>().tryGet(id); }
+
+    template <typename T>
+    const T *tryGet(EntityId id) const { return pool<T>().tryGet(id); }
+
+    // Pool for T, created on first use
+    template <typename T>
+    StorageOf<T> &pool()
+    {
+        const uint32_t type = typeIndex<T>();
+        if (type >= pools.size())
+            pools.resize(type + 1);
+        if (!pools[type])
+            pools[type] = std::make_unique<StorageOf<T>>();
+        return *static_cast<StorageOf<T> *>(pools[type].get());
+    }
+
+    // Read-only pool for T; an empty pool if nothing of that type was ever added
+    template <typename T>
+    const StorageOf<T> &pool() const
+    {
+        static const StorageOf<T> empty;
+        const uint32_t type = typeIndex<T>();
+        if (type >= pools.size() || !pools[type])
+            return empty;
+        return *static_cast<const StorageOf<T> *>(pools[type].get());
+    }
+
+    // Create the pools for Ts now. pool<T>() otherwise creates them lazily,
+    // which is not safe once systems run concurrently (see SystemScheduler).
+    template <typename... Ts>
+    void registerPools()
+    {
+        (pool<Ts>(), ...);
+    }
+
+    // Entities owning all of Ts; mark read-only components const
+    template <typename... Ts>
+    View<Ts...> view()
+    {
+        return View<Ts...>(&pool<std::remove_const_t<Ts>>()...);
+    }
+
+    // Read-only view: every component is const
+    template <typename... Ts>
+    View<const std::remove_const_t<Ts>...> view() const
+    {
+        return View<const std::remove_const_t<Ts>...>(&pool<std::remove_const_t<Ts>>()...);
+    }
+
+    // Drop all components (entity ids are left to the caller)
+    void clear()
+    {
+        for (auto &p : pools)
+        {
+            if (p)
+                p->clear();
+        }
+    }
+
+    // Make this store a copy of `other`: entity ids and every pool. Pools keep
+    // their capacity, so copying back and forth between a live store and a
+    // snapshot of it stops allocating once both have grown (see WorldSnapshot).
+    // Pools `other` does not have are emptied.
+    void copyFrom(const ComponentStore &other)
+    {
+        em = other.em;
+        if (pools.size() < other.pools.size())
+            pools.resize(other.pools.size());
+        for (std::size_t type = 0; type < pools.size(); ++type)
+        {
+            const IComponentPool *source = type < other.pools.size() ? other.pools[type].get() : nullptr;
+            if (!source)
+            {
+                if (pools[type])
+                    pools[type]->clear();
+            }
+            else if (!pools[type])
+                pools[type] = source->clone();
+            else
+                pools[type]->copyFrom(*source);
+        }
+    }
+
+    EntityManager &entities() { return em; }
+    const EntityManager &entities() const { return em; }
+
+private:
+    static uint32_t nextTypeIndex()
+    {
+        static std::atomic<uint32_t> counter{0};
+        return counter++;
+    }
+
+    // Stable small integer per component type, assigned on first use
+    template <typename T>
+    static uint32_t typeIndex()
+    {
+        static const uint32_t index = nextTypeIndex();
+        return index;
+    }
+
+    EntityManager &em;
+    std::vector<std::unique_ptr<IComponentPool>> pools; // indexed by typeIndex<T>()
+};
@@ -0,0 +1,69 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+// Simulation rate settings
+struct FixedStepConfig
+{
+    float hz{60.0f};          // simulation ticks per second
+    int subSteps{4};          // Box2D sub-steps per tick
+    int maxStepsPerFrame{5};  // catch-up limit; older backlog is dropped
+};
+
+// Accumulator-driven fixed timestep. Each rendered frame adds its real duration
+// and advance() returns how many ticks of exactly dt() to simulate. After a
+// hitch at most maxStepsPerFrame ticks run and the rest of the backlog is
+// dropped, so physics cost per second stays bounded. alpha() is the fraction
+// of a tick left in the accumulator: the blend factor between the previous and
+// current poses for rendering (see PoseCache::setInterpolation).
+class FixedTimestep
+{
+public:
+    explicit FixedTimestep(const FixedStepConfig &config = FixedStepConfig{}) { configure(config); }
+
+    void configure(const FixedStepConfig &config)
+    {
+        cfg = config;
+        cfg.hz = std::max(cfg.hz, 1.0f);
+        cfg.subSteps = std::max(cfg.subSteps, 1);
+        cfg.maxStepsPerFrame = std::max(cfg.maxStepsPerFrame, 1);
+        step = 1.0f / cfg.hz;
+        accumulator = 0.0f;
+    }
+
+    // Add a frame's real time; returns the number of ticks to run now
+    int advance(float frameSeconds)
+    {
+        accumulator += std::max(frameSeconds, 0.0f);
+
+        int steps = 0;
+        while (accumulator >= step && steps < cfg.maxStepsPerFrame)
+        {
+            accumulator -= step;
+            ++steps;
+        }
+        if (accumulator >= step)
+        {
+            // Too far behind: keep the fractional tick, drop the rest
+            dropped += static_cast<uint64_t>(accumulator / step);
+            accumulator = std::fmod(accumulator, step);
+        }
+        ticks += static_cast<uint64_t>(steps);
+        return steps;
+    }
+
+    float dt() const { return step; }
+    float alpha() const { return accumulator / step; }
+    const FixedStepConfig &config() const { return cfg; }
+
+    uint64_t tickCount() const { return ticks; }      // ticks simulated so far
+    uint64_t droppedTicks() const { return dropped; } // ticks skipped by the catch-up limit
+
+private:
+    FixedStepConfig cfg;
+    float step{1.0f / 60.0f};
+    float accumulator{0.0f};
+    uint64_t ticks{0};
+    uint64_t dropped{0};
+};
@@ -0,0 +1,94 @@
+#pragma once
+#include "raylib.h"
+
+#include "component_store.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Everything the player did that reaches the simulation during one fixed tick.
+// raylib is polled once per frame (InputSampler, systems/input_system.hpp) and
+// the next tick consumes the result, in this order: actions (toggles, reset,
+// quick save/load), ad click, thrower (aim, press, release), then the
+// simulation systems. The same TickInputs replayed from the same level start
+// give the same world, whatever the frame rate.
+struct TickInput
+{
+    // Left mouse button edges since the previous tick
+    enum Buttons : uint8_t
+    {
+        Press = 1u << 0,
+        Release = 1u << 1
+    };
+
+    // Key presses since the previous tick
+    enum Actions : uint16_t
+    {
+        TogglePause = 1u << 0,
+        ToggleDebug = 1u << 1,
+        ToggleConsolidation = 1u << 2,
+        ToggleChainLod = 1u << 3,
+        Reset = 1u << 4,
+        QuickSave = 1u << 5,
+        QuickLoad = 1u << 6
+    };
+
+    Vector2 pointer{0.0f, 0.0f}; // mouse in world pixels through the tick's camera (aim target)
+    Vector2 press{0.0f, 0.0f};   // mouse at the press, screen pixels (ad clicks); valid with Press
+    Vector2 camera{0.0f, 0.0f};  // GameCamera position the tick ran with (world pixels at the screen centre)
+    uint8_t buttons{0};
+    uint16_t actions{0};
+
+    bool pressed() const { return (buttons & Press) != 0; }
+    bool released() const { return (buttons & Release) != 0; }
+    bool has(Actions action) const { return (actions & action) != 0; }
+
+    // World region of a `size` screen centred on the camera: what the chain
+    // LOD treats as visible. Derived from the tick alone so a replay (windowed
+    // or headless) sees the same view as the recording.
+    Rectangle view(Vector2 size) const
+    {
+        return {camera.x - 0.5f * size.x, camera.y - 0.5f * size.y, size.x, size.y};
+    }
+};
+
+// Hash of every cached body pose and its entity id (bit patterns, FNV-1a):
+// equal worlds give equal sums, the first differing tick shows a divergence
+uint64_t WorldChecksum(const ComponentStore &store);
+
+// Input of a session, one TickInput per fixed tick from the level start, with
+// the level and rate it ran at and a WorldChecksum every checksumInterval
+// ticks so a replay can tell whether (and about when) it diverged.
+//
+// The file is little-endian binary: a header, then per tick one byte saying
+// which fields changed since the previous tick followed by only those fields
+// (an idle tick costs one byte, runs of up to 127 unchanged ticks share it),
+// then the checksums.
+class InputTrace
+{
+public:
+    std::string level;               // level file the session loaded
+    float hz{60.0f};                 // fixed ticks per second
+    int subSteps{4};                 // Box2D sub-steps per tick
+    uint32_t checksumInterval{60};   // ticks between checksums
+
+    // Recording: the input a tick ran with, then the world after the tick
+    void record(const TickInput &input) { inputs.push_back(input); }
+    void recordResult(const ComponentStore &store);
+
+    std::size_t size() const { return inputs.size(); }
+    const TickInput &at(std::size_t tick) const { return inputs[tick]; }
+
+    // Replay: compare the world after `ticks` ticks with the recording.
+    // False only on a mismatch; ticks without a stored checksum pass.
+    bool verify(std::size_t ticks, const ComponentStore &store) const;
+
+    bool save(const std::string &path) const;
+    bool load(const std::string &path);
+
+private:
+    std::vector<TickInput> inputs;
+    std::vector<uint64_t> checksums; // after ticks checksumInterval, 2 * checksumInterval, ...
+};
@@ -0,0 +1,143 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Completion counter (fence) for a group of jobs: each submitted job adds one,
+// each finished job removes one. JobSystem::wait() returns once it is zero.
+class JobCounter
+{
+public:
+    JobCounter() = default;
+    JobCounter(const JobCounter &) = delete;
+    JobCounter &operator=(const JobCounter &) = delete;
+
+    bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    std::atomic<uint32_t> pending{0};
+};
+
+// Work-stealing job system: a fixed set of worker threads, one job deque per
+// thread slot. A thread pushes and pops at the back of its own deque and
+// steals from the front of the others when it runs dry.
+// Slot 0 belongs to threads outside the pool (the main thread); workers use
+// 1..workerCount(). Waiting threads run jobs instead of blocking.
+// With zero workers (always under Emscripten) jobs run inside wait().
+class JobSystem
+{
+public:
+    // Range task: [begin, end) executed on thread slot `slot`
+    using TaskFn = void (*)(uint32_t begin, uint32_t end, uint32_t slot, void *context);
+
+    struct SlotStats
+    {
+        uint64_t jobs{0};        // jobs executed
+        uint64_t steals{0};      // jobs taken from another slot
+        double busySeconds{0.0}; // time spent running jobs
+        float utilization{0.0f}; // busySeconds / seconds since resetStats()
+    };
+
+    // One worker per extra hardware thread
+    static unsigned DefaultWorkerCount();
+
+    explicit JobSystem(unsigned workerCount = DefaultWorkerCount());
+    ~JobSystem();
+
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    unsigned workerCount() const { return static_cast<unsigned>(threads.size()); }
+    // Worker threads plus slot 0; upper bound for slot indices
+    unsigned threadCount() const { return static_cast<unsigned>(slots.size()); }
+    // Slot of the calling thread (0 outside the pool)
+    static uint32_t currentSlot();
+
+    // Queue a range task; counter (optional) is signalled when it finishes
+    void submit(TaskFn fn, void *context, uint32_t begin, uint32_t end, JobCounter *counter = nullptr);
+    // Queue a closure (allocates; prefer the TaskFn overload in hot paths)
+    void submit(std::function<void()> fn, JobCounter *counter = nullptr);
+
+    // Run queued jobs on this thread until counter reaches zero
+    void wait(JobCounter &counter);
+    // Run one queued job on this thread; false if every deque was empty
+    bool runOne();
+
+    // Split [0, count) into chunks of `grain` and run fn(begin, end, slot)
+    // across the pool; returns when every chunk is done
+    template <typename Fn>
+    void parallelFor(uint32_t count, uint32_t grain, Fn &&fn);
+
+    // Per-slot counters since the last resetStats() (index = slot)
+    std::vector<SlotStats> stats() const;
+    void resetStats();
+    // TraceLog one line per slot with jobs, steals and utilization
+    void logUtilization() const;
+
+private:
+    struct Job
+    {
+        TaskFn fn{nullptr};
+        void *context{nullptr};
+        uint32_t begin{0};
+        uint32_t end{0};
+        JobCounter *counter{nullptr};
+    };
+
+    struct Slot
+    {
+        std::mutex mutex;
+        std::deque<Job> queue;
+        std::atomic<uint64_t> busyNs{0};
+        std::atomic<uint64_t> jobs{0};
+        std::atomic<uint64_t> steals{0};
+    };
+
+    void push(const Job &job);
+    bool pop(uint32_t slot, Job &job);
+    bool steal(uint32_t thief, Job &job);
+    void execute(uint32_t slot, const Job &job);
+    void workerLoop(uint32_t slot);
+
+    std::vector<std::unique_ptr<Slot>> slots; // [0] = outside threads, [1..] = workers
+    std::vector<std::thread> threads;
+    std::mutex sleepMutex;
+    std::condition_variable sleepCv;
+    std::atomic<uint32_t> queued{0}; // jobs sitting in any deque
+    std::atomic<bool> stopping{false};
+    std::chrono::steady_clock::time_point statsStart;
+};
+
+template <typename Fn>
+void JobSystem::parallelFor(uint32_t count, uint32_t grain, Fn &&fn)
+{
+    if (count == 0)
+        return;
+    if (grain == 0)
+        grain = 1;
+    if (threads.empty() || count <= grain)
+    {
+        fn(0u, count, currentSlot());
+        return;
+    }
+
+    using F = std::remove_reference_t<Fn>;
+    TaskFn task = [](uint32_t begin, uint32_t end, uint32_t slot, void *context)
+    { (*static_cast<F *>(context))(begin, end, slot); };
+    void *context = const_cast<void *>(static_cast<const void *>(&fn));
+
+    JobCounter counter;
+    for (uint32_t begin = 0; begin < count; begin += grain)
+        submit(task, context, begin, std::min(count, begin + grain), &counter);
+    wait(counter);
+}
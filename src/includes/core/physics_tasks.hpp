@@ -0,0 +1,151 @@
+#pragma once
+#include "box2d/box2d.h"
+#include "raylib.h"
+#include "job_system.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+// Box2D task callbacks (b2WorldDef::enqueueTask/finishTask) running on the JobSystem.
+// Box2D's worker index is the job slot of the thread running the chunk, so the
+// world's workerCount is the job system's threadCount(). Must outlive the world.
+class PhysicsTasks
+{
+public:
+    static constexpr unsigned MaxBox2DWorkers = 64; // B2_MAX_WORKERS
+
+    explicit PhysicsTasks(JobSystem &jobs) : jobs(jobs) {}
+
+    PhysicsTasks(const PhysicsTasks &) = delete;
+    PhysicsTasks &operator=(const PhysicsTasks &) = delete;
+
+    // Point a world definition at this task system. With no job workers the
+    // world keeps Box2D's single-threaded path.
+    void configure(b2WorldDef &def)
+    {
+        const unsigned threads = jobs.threadCount();
+        if (threads <= 1)
+        {
+            def.workerCount = 1;
+            return;
+        }
+        if (threads > MaxBox2DWorkers)
+        {
+            TraceLog(LOG_WARNING, "PhysicsTasks: %d job threads exceed Box2D's %d workers, stepping single-threaded",
+                     (int)threads, (int)MaxBox2DWorkers);
+            def.workerCount = 1;
+            return;
+        }
+
+        def.workerCount = static_cast<int>(threads);
+        def.enqueueTask = &EnqueueTask;
+        def.finishTask = &FinishTask;
+        def.userTaskContext = this;
+    }
+
+private:
+    struct Task
+    {
+        b2TaskCallback *fn{nullptr};
+        void *context{nullptr};
+        int itemCount{0};
+        int chunkSize{1};
+        int chunks{0};
+        std::atomic<int> next{0}; // first chunk nobody has claimed yet
+        JobCounter counter;
+    };
+
+    // Claim the task's next chunk and run it on `slot`; false once all are claimed
+    static bool RunNextChunk(Task *task, uint32_t slot)
+    {
+        const int chunk = task->next.fetch_add(1, std::memory_order_relaxed);
+        if (chunk >= task->chunks)
+            return false;
+        const int begin = chunk * task->chunkSize;
+        const int end = std::min(task->itemCount, begin + task->chunkSize);
+        task->fn(begin, end, slot, task->context);
+        return true;
+    }
+
+    // Job body: one job per chunk, but the chunk it runs is whichever is next,
+    // which FinishTask may already have taken
+    static void RunChunk(uint32_t, uint32_t, uint32_t slot, void *context)
+    {
+        RunNextChunk(static_cast<Task *>(context), slot);
+    }
+
+    // Split [0, itemCount) into chunks of at least minRange, at most one per
+    // thread. A single chunk is still a job: the solver enqueues one task per
+    // worker (itemCount = minRange = 1) and those must run side by side, since
+    // they wait on each other's stages.
+    static void *EnqueueTask(b2TaskCallback *fn, int itemCount, int minRange, void *taskContext, void *userContext)
+    {
+        PhysicsTasks *self = static_cast<PhysicsTasks *>(userContext);
+        JobSystem &jobs = self->jobs;
+
+        if (itemCount <= 0)
+        {
+            // Nothing to split: run inline, Box2D skips finishTask for nullptr
+            fn(0, itemCount, JobSystem::currentSlot(), taskContext);
+            return nullptr;
+        }
+
+        const int maxChunks = static_cast<int>(jobs.threadCount());
+        const int chunks = std::clamp(itemCount / std::max(minRange, 1), 1, maxChunks);
+
+        Task *task = self->acquire();
+        task->fn = fn;
+        task->context = taskContext;
+        task->itemCount = itemCount;
+        task->chunkSize = (itemCount + chunks - 1) / chunks;
+        task->chunks = (itemCount + task->chunkSize - 1) / task->chunkSize;
+        task->next.store(0, std::memory_order_relaxed);
+
+        for (int i = 0; i < task->chunks; ++i)
+            jobs.submit(&RunChunk, task, 0, 0, &task->counter);
+        return task;
+    }
+
+    // The calling thread first runs the task's own unclaimed chunks, then
+    // other queued jobs until the task is done. wait() alone pops the newest
+    // job first: with the solver's one-task-per-worker pattern and no idle
+    // thread to steal, finishing worker 0 would run worker N-1, which spins
+    // until worker 0 signals a stage, and worker 0 would never start.
+    static void FinishTask(void *userTask, void *userContext)
+    {
+        PhysicsTasks *self = static_cast<PhysicsTasks *>(userContext);
+        Task *task = static_cast<Task *>(userTask);
+        while (RunNextChunk(task, JobSystem::currentSlot()))
+        {
+        }
+        self->jobs.wait(task->counter);
+        self->release(task);
+    }
+
+    Task *acquire()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (freeTasks.empty())
+        {
+            tasks.emplace_back(); // deque: addresses stay valid as it grows
+            return &tasks.back();
+        }
+        Task *task = freeTasks.back();
+        freeTasks.pop_back();
+        return task;
+    }
+
+    void release(Task *task)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        freeTasks.push_back(task);
+    }
+
+    JobSystem &jobs;
+    std::mutex mutex;
+    std::deque<Task> tasks;
+    std::vector<Task *> freeTasks;
+};
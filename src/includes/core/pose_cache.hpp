@@ -0,0 +1,341 @@
+#pragma once
+#include "box2d/box2d.h"
+#include "component_store.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Pose of a physics body in pixels; rotation kept as cos/sin so no trig is needed to draw
+struct BodyPose
+{
+    float x{0.0f};
+    float y{0.0f};
+    float c{1.0f};
+    float s{0.0f};
+
+    float angle() const { return atan2f(s, c); }
+
+    // Rotate a local pixel offset by the pose and translate it into world pixels
+    b2Vec2 transformPoint(b2Vec2 local) const
+    {
+        return {x + c * local.x - s * local.y, y + s * local.x + c * local.y};
+    }
+};
+
+// Structure-of-arrays pose buffer keyed by EntityId.
+// Refreshed once per physics step from Box2D body move events, so systems read
+// poses from here instead of calling b2Body_GetPosition/GetRotation per entity.
+// Bodies are tagged with their entity index (+1) as Box2D user data.
+// The pose before the last step is kept too: simulation reads get()/at(),
+// rendering reads interpolated(), blended by the fixed-timestep alpha.
+// Only bodies Box2D moved cost anything per step: the last step's movers are
+// listed in moved(), everything else (asleep, static, disabled) is settled and
+// keeps its pose, previous pose and awake flag untouched.
+class PoseCache final : public IComponentPool
+{
+public:
+    static constexpr uint32_t npos = 0xFFFFFFFFu;
+
+    void setUnitsPerMeter(float upm) { unitsPerMeter = upm; }
+
+    // Start caching a body's pose for an entity (reads the current transform once)
+    void track(EntityId id, b2BodyId body)
+    {
+        retag(id, body);
+        add(id, toPose(b2Body_GetTransform(body)));
+    }
+
+    // Tag a body with its entity again without touching the cached pose (a
+    // pooled body handed back by a snapshot restore lost its tag on release)
+    static void retag(EntityId id, b2BodyId body)
+    {
+        b2Body_SetUserData(body, reinterpret_cast<void *>(static_cast<uintptr_t>(id.index) + 1u));
+    }
+
+    // Overwrite a pose outside the step (teleports, spawns); no blend from the old pose
+    void sync(EntityId id, b2BodyId body)
+    {
+        if (has(id))
+        {
+            reset(sparse[id.index], toPose(b2Body_GetTransform(body)));
+            ++structure;
+        }
+    }
+
+    // Call before each physics step: the current poses become the previous ones.
+    // Only last step's movers differ, so this is O(moved), not O(bodies).
+    void storePrevious()
+    {
+        for (EntityId id : movedIds)
+        {
+            if (!has(id))
+                continue; // removed since the step
+            const uint32_t slot = sparse[id.index];
+            pxs[slot] = xs[slot];
+            pys[slot] = ys[slot];
+            pcs[slot] = cs[slot];
+            pss[slot] = ss[slot];
+        }
+    }
+
+    // Render blend factor in [0, 1]: 0 = previous step, 1 = current step
+    void setInterpolation(float alpha) { blend = alpha < 0.0f ? 0.0f : (alpha > 1.0f ? 1.0f : alpha); }
+    float interpolation() const { return blend; }
+
+    // Pull this step's body move events; sleeping and static bodies keep their last pose.
+    // Box2D reports every awake body, so a body without an event is asleep.
+    void refresh(b2WorldId world)
+    {
+        for (EntityId id : movedIds)
+        {
+            if (has(id))
+                awakeFlags[sparse[id.index]] = Settled;
+        }
+        movedIds.clear();
+
+        b2BodyEvents events = b2World_GetBodyEvents(world);
+        for (int i = 0; i < events.moveCount; ++i)
+        {
+            const b2BodyMoveEvent &ev = events.moveEvents[i];
+            uintptr_t tag = reinterpret_cast<uintptr_t>(ev.userData);
+            if (tag == 0)
+                continue; // body not owned by an entity
+            uint32_t index = static_cast<uint32_t>(tag - 1u);
+            if (index >= sparse.size() || sparse[index] == npos)
+                continue;
+            const uint32_t slot = sparse[index];
+            write(slot, toPose(ev.transform));
+            awakeFlags[slot] = ev.fellAsleep ? FellAsleep : Awake;
+            movedIds.push_back(dense[slot]); // fell-asleep bodies moved too: listed, not awake
+        }
+    }
+
+    // Set the pose of an entity that has no body of its own (e.g. a box merged
+    // into a spike, see MergedShape) after refresh(); it counts as moved this step
+    void move(EntityId id, const BodyPose &pose, bool awake)
+    {
+        if (!has(id))
+            return;
+        const uint32_t slot = sparse[id.index];
+        write(slot, pose);
+        awakeFlags[slot] = awake ? Awake : FellAsleep;
+        movedIds.push_back(id);
+    }
+
+    // Entities whose pose changed in the last refresh (Box2D event order)
+    const std::vector<EntityId> &moved() const { return movedIds; }
+
+    // Moved in the last step and did not fall asleep doing so
+    bool isAwake(EntityId id) const { return has(id) && awakeFlags[sparse[id.index]] == Awake; }
+    // Moved in the last step (including the step it fell asleep)
+    bool hasMoved(EntityId id) const { return has(id) && awakeFlags[sparse[id.index]] != Settled; }
+
+    // Bumped whenever an entity is added, removed or teleported. Consumers that
+    // follow moved() (e.g. SpatialGrid) resync fully when it changes.
+    uint32_t structureVersion() const { return structure; }
+
+    // Entity owning a tracked body (from its user data tag); invalid id if untracked
+    EntityId entityOf(b2BodyId body) const
+    {
+        uintptr_t tag = reinterpret_cast<uintptr_t>(b2Body_GetUserData(body));
+        if (tag == 0)
+            return EntityId{};
+        uint32_t index = static_cast<uint32_t>(tag - 1u);
+        if (index >= sparse.size() || sparse[index] == npos)
+            return EntityId{};
+        return dense[sparse[index]];
+    }
+
+    void add(EntityId id, BodyPose pose)
+    {
+        if (id.index >= sparse.size())
+            sparse.resize(id.index + 1, npos);
+
+        uint32_t &slot = sparse[id.index];
+        if (slot == npos)
+        {
+            slot = static_cast<uint32_t>(dense.size());
+            dense.push_back(id);
+            xs.push_back(0.0f);
+            ys.push_back(0.0f);
+            cs.push_back(1.0f);
+            ss.push_back(0.0f);
+            pxs.push_back(0.0f);
+            pys.push_back(0.0f);
+            pcs.push_back(1.0f);
+            pss.push_back(0.0f);
+            awakeFlags.push_back(Awake);
+        }
+        dense[slot] = id;
+        reset(slot, pose);
+        awakeFlags[slot] = Awake; // counts as moving until a step reports otherwise
+        movedIds.push_back(id);
+        ++structure;
+    }
+
+    void remove(EntityId id) override
+    {
+        if (!has(id))
+            return;
+        uint32_t slot = sparse[id.index];
+        uint32_t last = static_cast<uint32_t>(dense.size() - 1);
+        if (slot != last)
+        {
+            dense[slot] = dense[last];
+            xs[slot] = xs[last];
+            ys[slot] = ys[last];
+            cs[slot] = cs[last];
+            ss[slot] = ss[last];
+            pxs[slot] = pxs[last];
+            pys[slot] = pys[last];
+            pcs[slot] = pcs[last];
+            pss[slot] = pss[last];
+            awakeFlags[slot] = awakeFlags[last];
+            sparse[dense[slot].index] = slot;
+        }
+        dense.pop_back();
+        xs.pop_back();
+        ys.pop_back();
+        cs.pop_back();
+        ss.pop_back();
+        pxs.pop_back();
+        pys.pop_back();
+        pcs.pop_back();
+        pss.pop_back();
+        awakeFlags.pop_back();
+        sparse[id.index] = npos;
+        ++structure;
+    }
+
+    bool has(EntityId id) const override
+    {
+        return id.index < sparse.size() && sparse[id.index] != npos && dense[sparse[id.index]] == id;
+    }
+
+    // Unchecked access: caller guarantees has(id)
+    BodyPose get(EntityId id) const { return at(sparse[id.index]); }
+    // Pose before the last step (equal to get() for entities that did not move)
+    BodyPose previous(EntityId id) const { return previousAt(sparse[id.index]); }
+    // Pose to draw: previous -> current blended by interpolation() (nlerp for rotation)
+    BodyPose interpolated(EntityId id) const { return interpolatedAt(sparse[id.index]); }
+
+    void clear() override
+    {
+        sparse.clear();
+        dense.clear();
+        xs.clear();
+        ys.clear();
+        cs.clear();
+        ss.clear();
+        pxs.clear();
+        pys.clear();
+        pcs.clear();
+        pss.clear();
+        awakeFlags.clear();
+        movedIds.clear();
+        ++structure;
+    }
+
+    std::size_t size() const override { return dense.size(); }
+
+    std::unique_ptr<IComponentPool> clone() const override { return std::make_unique<PoseCache>(*this); }
+
+    // Snapshot copy: the render blend stays, and the structure version moves
+    // past both caches' so followers (SpatialGrid) resync
+    void copyFrom(const IComponentPool &other) override
+    {
+        const PoseCache &source = static_cast<const PoseCache &>(other);
+        const float keepBlend = blend;
+        const uint32_t version = (structure > source.structure ? structure : source.structure) + 1u;
+        *this = source;
+        blend = keepBlend;
+        structure = version;
+    }
+
+    // Dense access for linear scans
+    EntityId entity(std::size_t i) const { return dense[i]; }
+    const std::vector<EntityId> &entities() const { return dense; }
+    BodyPose at(std::size_t i) const { return BodyPose{xs[i], ys[i], cs[i], ss[i]}; }
+    BodyPose previousAt(std::size_t i) const { return BodyPose{pxs[i], pys[i], pcs[i], pss[i]}; }
+    BodyPose interpolatedAt(std::size_t i) const
+    {
+        if (xs[i] == pxs[i] && ys[i] == pys[i] && cs[i] == pcs[i] && ss[i] == pss[i])
+            return at(i); // settled: nothing to blend
+        const float a = blend;
+        BodyPose pose{pxs[i] + (xs[i] - pxs[i]) * a, pys[i] + (ys[i] - pys[i]) * a,
+                      pcs[i] + (cs[i] - pcs[i]) * a, pss[i] + (ss[i] - pss[i]) * a};
+        const float len2 = pose.c * pose.c + pose.s * pose.s;
+        if (len2 < 1e-6f)
+        {
+            // Half-turn in one step: no meaningful blend, snap to the current rotation
+            pose.c = cs[i];
+            pose.s = ss[i];
+        }
+        else
+        {
+            const float inv = 1.0f / sqrtf(len2);
+            pose.c *= inv;
+            pose.s *= inv;
+        }
+        return pose;
+    }
+    const float *x() const { return xs.data(); }
+    const float *y() const { return ys.data(); }
+    const float *cos() const { return cs.data(); }
+    const float *sin() const { return ss.data(); }
+
+private:
+    // Per-slot motion state from the last step
+    enum : uint8_t
+    {
+        Settled = 0,    // no move event
+        Awake = 1,      // moved, still awake
+        FellAsleep = 2  // moved, then fell asleep
+    };
+
+    BodyPose toPose(const b2Transform &t) const
+    {
+        return BodyPose{t.p.x * unitsPerMeter, t.p.y * unitsPerMeter, t.q.c, t.q.s};
+    }
+
+    void write(uint32_t slot, const BodyPose &pose)
+    {
+        xs[slot] = pose.x;
+        ys[slot] = pose.y;
+        cs[slot] = pose.c;
+        ss[slot] = pose.s;
+    }
+
+    // Current and previous pose both set: nothing to blend from
+    void reset(uint32_t slot, const BodyPose &pose)
+    {
+        write(slot, pose);
+        pxs[slot] = pose.x;
+        pys[slot] = pose.y;
+        pcs[slot] = pose.c;
+        pss[slot] = pose.s;
+    }
+
+    float unitsPerMeter{1.0f};
+    float blend{1.0f};
+    std::vector<uint32_t> sparse; // entity index -> dense slot (npos if absent)
+    std::vector<EntityId> dense;  // owning entity per dense slot
+    std::vector<float> xs;        // position x (pixels)
+    std::vector<float> ys;        // position y (pixels)
+    std::vector<float> cs;        // rotation cosine
+    std::vector<float> ss;        // rotation sine
+    std::vector<float> pxs;       // previous step, same layout
+    std::vector<float> pys;
+    std::vector<float> pcs;
+    std::vector<float> pss;
+    std::vector<uint8_t> awakeFlags; // Settled / Awake / FellAsleep per slot
+    std::vector<EntityId> movedIds;  // last refresh's movers (plus entities added since)
+    uint32_t structure{0};
+};
+
+template <>
+struct ComponentStorage<BodyPose>
+{
+    using type = PoseCache;
+};
@@ -0,0 +1,105 @@
+#pragma once
+#include "raylib.h"
+#include "box2d/box2d.h"
+
+#include "entity_manager.hpp"
+#include "component_store.hpp"
+#include "command_buffer.hpp"
+#include "body_pool.hpp"
+#include "spatial_grid.hpp"
+#include "world_snapshot.hpp"
+#include "input_trace.hpp"
+#include "../systems/logic_system.hpp"
+#include "../systems/lifetime_system.hpp"
+#include "../systems/consolidation_system.hpp"
+#include "../systems/chain_lod_system.hpp"
+
+#include <cstdint>
+#include <string>
+
+// Settings for a standalone world (defaults match the windowed game)
+struct SimulationConfig
+{
+    float unitsPerMeter{20.0f};
+    float hz{60.0f};                     // fixed ticks per second
+    int subSteps{4};                     // Box2D sub-steps per tick
+    b2Vec2 groundExtentPx{64.0f, 64.0f}; // half size of ground.png
+    b2Vec2 boxExtentPx{32.0f, 32.0f};    // half size of block.png (level boxes, projectiles)
+    Rectangle view{0.0f, 0.0f, 1920.0f, 1080.0f}; // chain LOD view until apply() centres one of this size on the tick's camera
+    DespawnRules despawn{};
+};
+
+// One self-contained game world: Box2D world, entity store, command buffer,
+// projectile pool and the simulation systems. tick() runs them on the calling
+// thread in the order of the game's `simulation` scheduler (physics, capture,
+// consolidate, scripts, lifetime, flush, chain LOD). Box2D steps single-threaded
+// here: batch runs get their parallelism from running many instances at once,
+// one per thread. No window, GL or input is touched; textures stay empty.
+// apply() feeds it a recorded TickInput the way the game does, so an input
+// trace replays here with the same result as in the window.
+class Simulation
+{
+public:
+    explicit Simulation(const SimulationConfig &config = SimulationConfig{});
+    ~Simulation();
+
+    Simulation(const Simulation &) = delete;
+    Simulation &operator=(const Simulation &) = delete;
+
+    // Build a level through level::LoadScenarioFromToml and size the projectile pool
+    bool loadLevel(const std::string &path);
+
+    // Advance one fixed tick of 1 / hz seconds
+    void tick();
+
+    // Player input for the next tick, handled like the game does before its
+    // simulation systems run: toggles (pause, consolidation, chain LOD),
+    // reset to the level start, quick save/load, then the thrower. Debug
+    // drawing and ad clicks do not reach the simulation and are ignored; the
+    // camera only places the chain LOD view (TickInput::view).
+    void apply(const TickInput &input);
+    bool paused() const { return logicCtx.isPaused; }
+
+    // Thrower entity (invalid id if the level has none)
+    EntityId thrower() const;
+    // Scripted throw: aim along `aimDir` (normalized here) with `charge`
+    // (clamped to the thrower's maxPower). The projectile spawns at the next
+    // tick's flush, like a mouse release. False without a thrower.
+    bool throwProjectile(b2Vec2 aimDir, float charge);
+
+    // Store the world and tick count / put them back (rollback, instant
+    // resets). restore() drops pending commands; false if the snapshot no
+    // longer fits this world (see WorldSnapshot).
+    void capture(WorldSnapshot &snapshot) const;
+    bool restore(const WorldSnapshot &snapshot);
+
+    float dt() const { return 1.0f / cfg.hz; }
+    uint64_t tickCount() const { return ticks; }
+    const SimulationConfig &config() const { return cfg; }
+
+    b2WorldId world() const { return worldId; }
+    ComponentStore &components() { return store; }
+    const ComponentStore &components() const { return store; }
+    LogicContext &logic() { return logicCtx; }
+    const LogicContext &logic() const { return logicCtx; }
+
+private:
+    SimulationConfig cfg;
+    b2WorldId worldId{b2_nullWorldId};
+    EntityManager entities;
+    ComponentStore store{entities};
+    CommandBuffer commands;
+    BodyPool projectilePool;
+    SpatialGrid grid{64.0f};
+    Sprite emptySprite{};
+    b2Polygon groundPolygon{};
+    b2Polygon boxPolygon{};
+    b2Vec2 boxExtent{};
+    LogicContext logicCtx;
+    LifetimeContext lifetimeCtx;
+    ConsolidationContext consolidationCtx;
+    ChainLodContext chainLodCtx;
+    WorldSnapshot levelStart; // taken by loadLevel
+    WorldSnapshot quickSave;
+    uint64_t ticks{0};
+};
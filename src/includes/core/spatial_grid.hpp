@@ -0,0 +1,88 @@
+#pragma once
+#include "entity_manager.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class PoseCache;
+
+// Uniform spatial hash grid over entity positions (pixels) for "what is near X"
+// queries. Entities are points; cells are `cellSize` pixels square and only
+// occupied cells exist (hash map keyed by packed cell coordinates).
+// update() follows the pose cache incrementally: an entity only changes bucket
+// when it crosses a cell border, and entities without a pose are dropped.
+// While the cache's entity set is unchanged only PoseCache::moved() is visited,
+// so a settled world costs nothing to keep in sync.
+// Queries write matching ids into a caller buffer and return the total number of
+// matches (like snprintf: at most `capacity` are written). Queries are const and
+// may run concurrently; update() may not run alongside them.
+class SpatialGrid
+{
+public:
+    explicit SpatialGrid(float cellSize = 64.0f);
+
+    float cellSize() const { return cell; }
+    // Changing the cell size rebuckets every entity
+    void setCellSize(float cellSize);
+
+    // Sync with the pose cache: insert new entities, move the ones that changed
+    // cell, drop the ones whose pose is gone. Full pass only after spawns,
+    // despawns or teleports; otherwise just the last step's movers.
+    void update(const PoseCache &poses);
+
+    // Manual maintenance for points that are not in the pose cache
+    void insert(EntityId id, float x, float y);
+    void move(EntityId id, float x, float y);
+    void remove(EntityId id);
+    bool contains(EntityId id) const;
+    void clear();
+
+    std::size_t size() const { return items.size(); }
+    std::size_t cellCount() const { return cells.size(); }
+
+    // Entities within `radius` of (x, y)
+    std::size_t queryRadius(float x, float y, float radius, EntityId *out, std::size_t capacity) const;
+    // Entities inside [minX, maxX] x [minY, maxY]
+    std::size_t queryAabb(float minX, float minY, float maxX, float maxY, EntityId *out, std::size_t capacity) const;
+    // Entities within `radius` of segment a-b (a capsule; radius 0 = on the line)
+    std::size_t querySegment(float ax, float ay, float bx, float by, float radius, EntityId *out, std::size_t capacity) const;
+
+private:
+    static constexpr uint32_t npos = 0xFFFFFFFFu;
+
+    struct Item
+    {
+        EntityId id;
+        float x;
+        float y;
+        uint64_t cell;   // packed cell key
+        uint32_t bucket; // position inside cells[cell]
+        uint32_t stamp;  // last update() that saw this entity
+    };
+
+    int32_t cellCoord(float v) const;
+    static uint64_t pack(int32_t cx, int32_t cy)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+    }
+
+    void link(uint32_t slot);   // add item to its cell bucket
+    void unlink(uint32_t slot); // remove item from its cell bucket
+    void erase(uint32_t slot);  // remove item entirely (swap with last)
+    void place(EntityId id, float x, float y, uint32_t stamp);
+
+    // Calls fn(item) for every item in cells [cx0, cx1] x [cy0, cy1]
+    template <typename Fn>
+    void forCells(int32_t cx0, int32_t cy0, int32_t cx1, int32_t cy1, Fn &&fn) const;
+
+    float cell;
+    float invCell;
+    uint32_t epoch{0};
+    bool synced{false};          // a full update() has run
+    uint32_t syncedVersion{0};   // PoseCache::structureVersion() at that time
+    std::vector<uint32_t> sparse; // entity index -> item slot (npos if absent)
+    std::vector<Item> items;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> cells; // cell -> item slots
+};
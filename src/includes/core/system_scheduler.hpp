@@ -0,0 +1,243 @@
+#pragma once
+#include "raylib.h"
+#include "job_system.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// What a system touches. Keys are types: components (Impaled, BodyPose, ...)
+// or resources (b2WorldId for the physics world, CommandBuffer, GameCamera,
+// AdvertisementSystem, ...). Two systems conflict when one writes a key the
+// other reads or writes; an exclusive system conflicts with everything.
+class SystemAccess
+{
+public:
+    template <typename... Ts>
+    SystemAccess &reads()
+    {
+        (readKeys.push_back(keyOf<Ts>()), ...);
+        return *this;
+    }
+
+    template <typename... Ts>
+    SystemAccess &writes()
+    {
+        (writeKeys.push_back(keyOf<Ts>()), ...);
+        return *this;
+    }
+
+    // Structural changes (e.g. command buffer flush): runs alone
+    SystemAccess &exclusive()
+    {
+        isExclusive = true;
+        return *this;
+    }
+
+    bool conflictsWith(const SystemAccess &other) const
+    {
+        if (isExclusive || other.isExclusive)
+            return true;
+        return overlaps(writeKeys, other.writeKeys) ||
+               overlaps(writeKeys, other.readKeys) ||
+               overlaps(readKeys, other.writeKeys);
+    }
+
+private:
+    static bool overlaps(const std::vector<uint32_t> &a, const std::vector<uint32_t> &b)
+    {
+        for (uint32_t x : a)
+        {
+            for (uint32_t y : b)
+            {
+                if (x == y)
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    static uint32_t nextKey()
+    {
+        static std::atomic<uint32_t> counter{0};
+        return counter++;
+    }
+
+    template <typename T>
+    static uint32_t keyOf()
+    {
+        static const uint32_t key = nextKey();
+        return key;
+    }
+
+    std::vector<uint32_t> readKeys;
+    std::vector<uint32_t> writeKeys;
+    bool isExclusive{false};
+};
+
+// Runs registered systems once per frame on the JobSystem.
+// build() turns the declared access into a DAG once: a system depends on every
+// earlier-registered system it conflicts with, so results match running them
+// serially in registration order. run() executes the DAG; systems without a
+// path between them run concurrently. MainThread systems (anything calling
+// raylib) only run on the thread calling run(), which also helps with jobs.
+// With no job workers (always under Emscripten) run() executes systems serially.
+class SystemScheduler
+{
+public:
+    using SystemFn = std::function<void(float dt)>;
+
+    enum class Affinity
+    {
+        Any,
+        MainThread
+    };
+
+    explicit SystemScheduler(JobSystem &jobs) : jobs(jobs) {}
+
+    SystemScheduler(const SystemScheduler &) = delete;
+    SystemScheduler &operator=(const SystemScheduler &) = delete;
+
+    void add(std::string name, SystemAccess access, SystemFn fn, Affinity affinity = Affinity::Any)
+    {
+        System sys;
+        sys.name = std::move(name);
+        sys.access = std::move(access);
+        sys.fn = std::move(fn);
+        sys.affinity = affinity;
+        systems.push_back(std::move(sys));
+        built = false;
+    }
+
+    // Build the dependency graph (once, after every add)
+    void build()
+    {
+        std::size_t edges = 0;
+        for (std::size_t j = 0; j < systems.size(); ++j)
+        {
+            systems[j].dependencyCount = 0;
+            systems[j].dependents.clear();
+        }
+        for (std::size_t j = 0; j < systems.size(); ++j)
+        {
+            for (std::size_t i = 0; i < j; ++i)
+            {
+                if (systems[i].access.conflictsWith(systems[j].access))
+                {
+                    systems[i].dependents.push_back(j);
+                    ++systems[j].dependencyCount;
+                    ++edges;
+                }
+            }
+        }
+        pending = std::make_unique<std::atomic<uint32_t>[]>(systems.size());
+        built = true;
+        TraceLog(LOG_INFO, "Scheduler: %d systems, %d dependencies, %d job workers",
+                 (int)systems.size(), (int)edges, (int)jobs.workerCount());
+    }
+
+    // Run every system once; returns when all have finished
+    void run(float dt)
+    {
+        if (!built)
+            build();
+
+        if (jobs.workerCount() == 0)
+        {
+            // Registration order is a topological order of the DAG
+            for (System &sys : systems)
+                sys.fn(dt);
+            return;
+        }
+
+        frameDt = dt;
+        remaining.store(static_cast<uint32_t>(systems.size()));
+        for (std::size_t i = 0; i < systems.size(); ++i)
+            pending[i].store(systems[i].dependencyCount);
+        for (std::size_t i = 0; i < systems.size(); ++i)
+        {
+            if (systems[i].dependencyCount == 0)
+                dispatch(i);
+        }
+
+        // The calling thread runs MainThread systems and helps with queued jobs
+        // until the frame is done. It never sleeps: jobs pushed later (Box2D
+        // solver chunks, parallelFor ranges, systems dispatched by workers)
+        // must find it, as JobSystem::wait() does.
+        while (remaining.load() > 0)
+        {
+            std::size_t index;
+            if (popMainReady(index))
+            {
+                execute(index);
+                continue;
+            }
+            if (!jobs.runOne())
+                std::this_thread::yield(); // remaining work is running elsewhere
+        }
+    }
+
+    std::size_t systemCount() const { return systems.size(); }
+
+private:
+    struct System
+    {
+        std::string name;
+        SystemAccess access;
+        SystemFn fn;
+        Affinity affinity{Affinity::Any};
+        std::vector<std::size_t> dependents; // systems waiting on this one
+        uint32_t dependencyCount{0};
+    };
+
+    void dispatch(std::size_t index)
+    {
+        if (systems[index].affinity == Affinity::MainThread)
+        {
+            std::lock_guard<std::mutex> lock(mainMutex);
+            mainReady.push_back(index);
+            return;
+        }
+
+        jobs.submit([](uint32_t begin, uint32_t, uint32_t, void *context)
+                    { static_cast<SystemScheduler *>(context)->execute(begin); },
+                    this, static_cast<uint32_t>(index), static_cast<uint32_t>(index + 1));
+    }
+
+    bool popMainReady(std::size_t &index)
+    {
+        std::lock_guard<std::mutex> lock(mainMutex);
+        if (mainReady.empty())
+            return false;
+        index = mainReady.back();
+        mainReady.pop_back();
+        return true;
+    }
+
+    void execute(std::size_t index)
+    {
+        systems[index].fn(frameDt);
+        for (std::size_t dep : systems[index].dependents)
+        {
+            if (pending[dep].fetch_sub(1) == 1)
+                dispatch(dep);
+        }
+        remaining.fetch_sub(1);
+    }
+
+    JobSystem &jobs;
+    std::vector<System> systems;
+    std::unique_ptr<std::atomic<uint32_t>[]> pending; // unfinished dependencies per system this frame
+    bool built{false};
+
+    std::atomic<uint32_t> remaining{0};
+    float frameDt{0.0f};
+    std::mutex mainMutex;
+    std::vector<std::size_t> mainReady; // MainThread systems whose dependencies are done
+};
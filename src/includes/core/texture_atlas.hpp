@@ -0,0 +1,77 @@
+#pragma once
+#include "raylib.h"
+
+#include "../components/sprite.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Level textures and small ad creatives packed into a few atlas pages.
+// Built offline by the-impale-atlas (src/tools/atlas_main.cpp) into a page
+// PNG per page plus a TOML manifest; at runtime find() maps an image's
+// original path ("box.png", "ads/banner_top.png", with or without the
+// "/assets/" prefix of the web build) to its page and rectangle, so level
+// files keep naming the source images. Images that are not in the atlas are
+// loaded on their own by the caller.
+//
+// Manifest (atlas.toml, page paths relative to it):
+//   pages = ["atlas_0.png"]
+//   [[region]]
+//   path = "box.png"
+//   page = 0
+//   x = 2
+//   y = 2
+//   width = 64
+//   height = 64
+class TextureAtlas
+{
+public:
+    TextureAtlas() = default;
+    TextureAtlas(const TextureAtlas &) = delete;
+    TextureAtlas &operator=(const TextureAtlas &) = delete;
+    ~TextureAtlas() { unload(); }
+
+    // Read the manifest and upload its pages (needs a GL context).
+    // False, with nothing loaded, if the manifest or a page is missing.
+    bool load(const std::string &manifestPath);
+    void unload();
+
+    // Region of an original image, or nullptr if it was not packed
+    const Sprite *find(const std::string &path) const;
+
+    std::size_t pageCount() const { return pages.size(); }
+    std::size_t regionCount() const { return regions.size(); }
+
+    // Atlas key of a path: '/' separators, without "./" or an "assets/" prefix
+    static std::string Key(const std::string &path);
+
+private:
+    std::vector<Texture> pages;
+    std::unordered_map<std::string, Sprite> regions;
+};
+
+// Offline packing (CPU images only, no GL context needed)
+struct AtlasBuildOptions
+{
+    int pageSize{2048};     // maximum page width and height
+    int padding{2};         // gap around each image, filled by repeating its edge
+    int maxImageSize{512};  // larger images stay separate textures
+};
+
+struct AtlasPlacement
+{
+    int page{-1}; // -1: did not fit (larger than a page)
+    Rectangle rect{0, 0, 0, 0};
+};
+
+// Shelf packing, tallest images first: one placement per size, in input order,
+// and the used width/height of each page
+std::vector<AtlasPlacement> PackAtlas(const std::vector<Vector2> &sizes, const AtlasBuildOptions &options,
+                                      std::vector<Vector2> &pageSizes);
+
+// Pack the images (paths relative to `root`) into outputDir/atlas_N.png and
+// outputDir/atlas.toml. Images over options.maxImageSize are skipped.
+// Returns the number of packed images, or -1 if nothing could be written.
+int BuildAtlas(const std::string &root, const std::vector<std::string> &images, const std::string &outputDir,
+               const AtlasBuildOptions &options);
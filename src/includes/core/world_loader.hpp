@@ -6,7 +6,7 @@
 #include "box2d/box2d.h"
 
 #include "../entities/types.hpp"
-#include "../core/entity_manager.hpp"
+#include "../core/component_store.hpp"
 
 // Level loader from TOML configuration
 // Schema (example):
@@ -30,28 +30,23 @@
 
 namespace level
 {
-    // Callback for loading textures on-demand
-    using TextureLoaderFn = std::function<Texture(const std::string &path)>;
+    // Callback for loading textures on-demand (a whole file or its atlas region)
+    using TextureLoaderFn = std::function<Sprite(const std::string &path)>;
 
     struct BuildContext
     {
-        EntityManager &em;
+        ComponentStore &store; // receives every entity created by the level
         b2WorldId world;
         float unitsPerMeter{50.0f};
-        const Texture &groundTexture;
-        const Texture &boxTexture;
+        const Sprite &groundSprite;
+        const Sprite &boxSprite;
         const b2Polygon &groundPolygon;
         const b2Polygon &boxPolygon;
         const b2Vec2 &groundExtentPx;
         const b2Vec2 &boxExtentPx;
-        std::vector<GameEntity> &grounds;
-        std::vector<GameEntity> &boxes;
-        std::vector<GameEntity> &obstacles;
-        std::vector<GameEntity> &spikes;
-        std::vector<GameEntity> &throwers;
         TextureLoaderFn textureLoader; // Callback to load textures dynamically
     };
 
-    // Loads scenario and populates entity vectors. Returns true on success.
+    // Loads scenario and populates the component store. Returns true on success.
     bool LoadScenarioFromToml(const std::string &path, BuildContext &ctx);
 }
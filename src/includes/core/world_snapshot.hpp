@@ -0,0 +1,103 @@
+#pragma once
+#include "box2d/box2d.h"
+
+#include "entity_manager.hpp"
+#include "component_store.hpp"
+#include "../entities/types.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Copy of a running world that can be restored in place: a level reset without
+// reparsing TOML, rebuilding bodies or reloading textures, and the rollback
+// point for replays.
+//
+// capture() copies every component pool and the entity ids into a private
+// store, then reads back from Box2D what the components do not hold: body
+// transforms, velocities, awake/enabled flags, impale joint settings and the
+// polygons of merged boxes. restore() reuses the existing bodies: whatever the
+// live world built since (impale joints, merged shapes, chain links, borrowed
+// projectile bodies) is torn down, the pools are copied back, pooled bodies
+// are taken out of their BodyPool again, then body state, merged shapes and
+// joints are reapplied. Joints and shapes are cheap and recreated; bodies are
+// never created, so a restore only fails if a body captured here was destroyed
+// since (then reload the level).
+//
+// Expanded chain spikes are stored collapsed: the hook keeps its pose on the
+// rope and the chain LOD expands the chain again when it is hit. Box2D's
+// contact cache and joint impulses are not part of the snapshot, so a
+// restored world continues close to, but not bit-exactly like, the original.
+// Capture and restore at a sync point (after the flush, command buffer empty).
+class WorldSnapshot
+{
+public:
+    WorldSnapshot() = default;
+    WorldSnapshot(const WorldSnapshot &) = delete;
+    WorldSnapshot &operator=(const WorldSnapshot &) = delete;
+
+    void capture(const ComponentStore &store);
+
+    // Put the live world back into the captured state. False (world left
+    // untouched) if nothing was captured or a captured body no longer exists.
+    bool restore(ComponentStore &store, b2WorldId world, float unitsPerMeter) const;
+
+    bool empty() const { return !taken; }
+    // Bodies whose state is stored (entity bodies and parked merged boxes)
+    std::size_t bodyCount() const { return bodies.size(); }
+
+    uint64_t tick{0}; // owner's tick counter at capture (left to the owner)
+
+private:
+    struct BodyState
+    {
+        EntityId entity;
+        b2BodyId body;
+        b2Transform transform;
+        b2Vec2 linearVelocity;
+        float angularVelocity;
+        bool awake;
+        bool enabled;
+    };
+
+    // Shape of a merged box on its anchor's body
+    struct MergedRecord
+    {
+        EntityId entity;
+        b2Polygon polygon;
+        float density;
+        float friction;
+        float restitution;
+        b2Filter filter;
+    };
+
+    // Impale joint (see CaptureBox): revolute, or distance with its rope settings
+    struct JointRecord
+    {
+        EntityId owner;
+        b2JointType type;
+        b2BodyId bodyA;
+        b2BodyId bodyB;
+        b2Vec2 localAnchorA;
+        b2Vec2 localAnchorB;
+        bool collideConnected;
+        float length;
+        bool enableLimit;
+        float minLength;
+        float maxLength;
+        bool enableSpring;
+        float hertz;
+        float dampingRatio;
+    };
+
+    EntityManager entities;
+    ComponentStore image{entities};
+    std::vector<BodyState> bodies;
+    std::vector<MergedRecord> merged;
+    std::vector<JointRecord> joints;
+    bool taken{false};
+
+    // restore() scratch, kept between calls so a reset does not allocate
+    mutable std::vector<EntityId> expandedScratch;
+    mutable std::vector<std::pair<EntityId, b2JointId>> ropeScratch;
+};
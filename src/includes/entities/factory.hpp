@@ -3,6 +3,8 @@
 #include "box2d/box2d.h"
 
 #include "types.hpp"
+#include <algorithm>
+#include <cmath>
 #include <vector>
 #include "../components/physics_body.hpp"
 #include "../components/transform.hpp"
@@ -10,153 +12,167 @@
 #include "../components/script.hpp"
 #include "../systems/render_system.hpp"
 #include "../core/entity_manager.hpp"
+#include "../core/body_pool.hpp"
 
-// Internal helper to construct a generic entity with given body type
-inline void DefaultUpdate(GameEntity & /*e*/, float /*dt*/)
-{
-    // no-op by default
-}
-
-inline void SpikeUpdate(GameEntity &e, float dt)
+inline void SpikeUpdate(ComponentStore &store, EntityId id, float dt)
 {
     // Rotate saw blades
-    if (e.spikeProps.type == SpikeType::SAW && e.spikeProps.rotationSpeed != 0.0f)
+    const SpikeProperties &spikeProps = store.get<SpikeProperties>(id);
+    SawRotation *spin = store.tryGet<SawRotation>(id);
+    if (spin && spikeProps.rotationSpeed != 0.0f)
     {
-        e.spikeProps.currentRotation += e.spikeProps.rotationSpeed * dt;
-        if (e.spikeProps.currentRotation >= 360.0f)
-            e.spikeProps.currentRotation -= 360.0f;
-        if (e.spikeProps.currentRotation < 0.0f)
-            e.spikeProps.currentRotation += 360.0f;
+        spin->degrees += spikeProps.rotationSpeed * dt;
+        if (spin->degrees >= 360.0f)
+            spin->degrees -= 360.0f;
+        if (spin->degrees < 0.0f)
+            spin->degrees += 360.0f;
     }
 }
 
-inline void DefaultRender(const GameEntity &e, float unitsPerMeter)
+inline void DefaultRender(const ComponentStore &store, EntityId id, float /*unitsPerMeter*/, SpriteBatch &batch)
 {
-    DrawSprite(e.body, e.sprite, e.transform, e.visual, unitsPerMeter);
+    DrawSprite(batch, DrawPose(store, id), store.get<Sprite>(id), store.get<SpriteTransform>(id),
+               store.get<VisualStyle>(id));
 }
 
-inline void DrawSolidBox(const GameEntity &e, float unitsPerMeter, Color color)
+inline void DrawSolidBox(const ComponentStore &store, EntityId id, SpriteBatch &batch, Color color)
 {
-    // Draw axis-aligned rectangle at body's transform using extent from transform
-    b2Vec2 p = b2Body_GetPosition(e.body.id);
-    b2Rot rot = b2Body_GetRotation(e.body.id);
-    float radians = b2Rot_GetAngle(rot);
-    Vector2 center = {p.x * unitsPerMeter, p.y * unitsPerMeter};
-    Vector2 size = {2.0f * e.transform.extent.x, 2.0f * e.transform.extent.y};
-    DrawRectanglePro((Rectangle){center.x, center.y, size.x, size.y},
-                     (Vector2){e.transform.extent.x, e.transform.extent.y},
-                     RAD2DEG * radians, color);
+    // Rectangle at body's transform using extent from transform
+    const BodyPose pose = DrawPose(store, id);
+    const SpriteTransform &transform = store.get<SpriteTransform>(id);
+    batch.rect({pose.x, pose.y}, {transform.extent.x, transform.extent.y}, pose.c, pose.s, color);
 }
 
-inline void ObstacleRender(const GameEntity &e, float unitsPerMeter)
+// Sprite image stretched over the body's extent
+inline void DrawTexturedBox(const ComponentStore &store, EntityId id, SpriteBatch &batch)
 {
-    // Draw textured rectangle at body's transform
-    b2Vec2 p = b2Body_GetPosition(e.body.id);
-    b2Rot rot = b2Body_GetRotation(e.body.id);
-    float radians = b2Rot_GetAngle(rot);
-    Vector2 center = {p.x * unitsPerMeter, p.y * unitsPerMeter};
-    Vector2 size = {2.0f * e.transform.extent.x, 2.0f * e.transform.extent.y};
-
-    Rectangle source = {0, 0, (float)e.sprite.texture.width, (float)e.sprite.texture.height};
-    Rectangle dest = {center.x, center.y, size.x, size.y};
-    Vector2 origin = {e.transform.extent.x, e.transform.extent.y};
-
-    DrawTexturePro(e.sprite.texture, source, dest, origin, RAD2DEG * radians, WHITE);
+    const BodyPose pose = DrawPose(store, id);
+    const SpriteTransform &transform = store.get<SpriteTransform>(id);
+    const Sprite &sprite = store.get<Sprite>(id);
+    batch.box(sprite.texture, sprite.source, {pose.x, pose.y}, {transform.extent.x, transform.extent.y}, pose.c, pose.s,
+              WHITE);
 }
 
-inline void SpikeRender(const GameEntity &e, float unitsPerMeter)
+inline void ObstacleRender(const ComponentStore &store, EntityId id, float /*unitsPerMeter*/, SpriteBatch &batch)
 {
-    b2Vec2 p = b2Body_GetPosition(e.body.id);
-    Vector2 center = {p.x * unitsPerMeter, p.y * unitsPerMeter};
-    float r = 0.5f * (e.transform.extent.x + e.transform.extent.y);
+    DrawTexturedBox(store, id, batch);
+}
 
-    switch (e.spikeProps.type)
-    {
-    case SpikeType::NORMAL:
-        // Draw textured square for spike
-        {
-            b2Rot rot = b2Body_GetRotation(e.body.id);
-            float radians = b2Rot_GetAngle(rot);
-            Vector2 size = {2.0f * e.transform.extent.x, 2.0f * e.transform.extent.y};
+inline void SpikeRender(const ComponentStore &store, EntityId id, float /*unitsPerMeter*/, SpriteBatch &batch)
+{
+    const BodyPose pose = DrawPose(store, id);
+    const SpriteTransform &transform = store.get<SpriteTransform>(id);
+    const VisualStyle &visual = store.get<VisualStyle>(id);
+    const SpikeProperties &spikeProps = store.get<SpikeProperties>(id);
 
-            Rectangle source = {0, 0, (float)e.sprite.texture.width, (float)e.sprite.texture.height};
-            Rectangle dest = {center.x, center.y, size.x, size.y};
-            Vector2 origin = {e.transform.extent.x, e.transform.extent.y};
+    Vector2 center = {pose.x, pose.y};
+    float r = 0.5f * (transform.extent.x + transform.extent.y);
 
-            DrawTexturePro(e.sprite.texture, source, dest, origin, RAD2DEG * radians, WHITE);
-        }
+    // Saws, untextured spikes, hooks and the chain anchor are distance-field
+    // quads when the batch has the SDF shader: one run for all of them
+    const bool sdf = batch.hasSdf();
+
+    switch (spikeProps.type)
+    {
+    case SpikeType::NORMAL:
+        // Textured square for spike
+        if (sdf && (!visual.useTexture || store.get<Sprite>(id).texture.id == 0))
+            batch.roundedBox(center, {transform.extent.x, transform.extent.y}, visual.roundness, pose.c, pose.s,
+                             visual.color);
+        else
+            DrawTexturedBox(store, id, batch);
         break;
 
     case SpikeType::SAW:
+    {
         // Rotating saw blade
-        DrawCircleV(center, r, e.visual.color);
-        for (int i = 0; i < 8; ++i)
+        const SawRotation *spin = store.tryGet<SawRotation>(id);
+        const float sawDegrees = spin ? spin->degrees : 0.0f;
+        if (sdf)
         {
-            float a = (2.0f * PI * i) / 8.0f + DEG2RAD * e.spikeProps.currentRotation;
+            const float a = DEG2RAD * sawDegrees;
+            batch.saw(center, r, spikeProps.teeth, cosf(a), sinf(a), visual.color);
+            break;
+        }
+        const int teeth = std::max(spikeProps.teeth, 1);
+        const float width = 4.8f / teeth; // tooth arc: 0.6 rad with 8 teeth
+        batch.circle(center, r, visual.color);
+        for (int i = 0; i < teeth; ++i)
+        {
+            float a = (2.0f * PI * i) / teeth + DEG2RAD * sawDegrees;
             Vector2 tooth1 = {center.x + cosf(a) * r, center.y + sinf(a) * r};
-            Vector2 tooth2 = {center.x + cosf(a + 0.3f) * (r * 1.3f), center.y + sinf(a + 0.3f) * (r * 1.3f)};
-            Vector2 tooth3 = {center.x + cosf(a + 0.6f) * r, center.y + sinf(a + 0.6f) * r};
-            DrawTriangle(tooth1, tooth2, tooth3, DARKGRAY);
+            Vector2 tooth2 = {center.x + cosf(a + 0.5f * width) * (r * 1.3f),
+                              center.y + sinf(a + 0.5f * width) * (r * 1.3f)};
+            Vector2 tooth3 = {center.x + cosf(a + width) * r, center.y + sinf(a + width) * r};
+            batch.triangle(tooth1, tooth2, tooth3, DARKGRAY);
         }
-        DrawCircleV(center, r * 0.3f, GRAY);
+        batch.circle(center, r * 0.3f, GRAY);
         break;
+    }
 
     case SpikeType::CHAIN:
     {
-        // Rope + hook: script.user holds the context
-        struct ChainContext
-        {
-            b2BodyId hookBody;
-            float halfW;
-            float halfH;
-        };
-        auto *ctx = (e.script.user != nullptr) ? static_cast<ChainContext *>(e.script.user) : nullptr;
+        // Rope or links + hook: state lives in the spike's ChainContext
+        const ChainContext *ctx = store.tryGet<ChainContext>(id);
         if (ctx)
         {
-            // Draw rope as a line from spike bottom to hook top
-            float spikeHalfM = (e.transform.extent.y / unitsPerMeter);
-
-            b2RevoluteJointDef jointDef = b2DefaultRevoluteJointDef();
-
-            // Vector2 anchorBot = {center.x, center.y + e.transform.extent.y};
-            // b2Vec2 hp = b2Body_GetPosition(ctx->hookBody);
-            // b2Rot hr = b2Body_GetRotation(ctx->hookBody);
-            // float ha = b2Rot_GetAngle(hr);
-            // Vector2 hc = {hp.x * unitsPerMeter, hp.y * unitsPerMeter};
-            // Vector2 hookTopOffset = {0.0f, -ctx->halfH * e.spikeProps.hookScaleH};
-            // // rotate offset by hook angle
-            // float ca = cosf(ha), sa = sinf(ha);
-            // Vector2 hookTop = {hc.x + hookTopOffset.x * ca - hookTopOffset.y * sa, hc.y + hookTopOffset.x * sa + hookTopOffset.y * ca};
-            // DrawLineEx(anchorBot, hookTop, 3.0f, DARKGRAY);
-
-            // Draw hook rectangle
-            // Vector2 hsize = {2.0f * ctx->halfW * e.spikeProps.hookScaleW, 2.0f * ctx->halfH * e.spikeProps.hookScaleH};
-            // DrawRectanglePro((Rectangle){hc.x, hc.y, hsize.x, hsize.y}, (Vector2){hsize.x * 0.5f, hsize.y * 0.5f}, RAD2DEG * ha, e.visual.color);
+            if (ctx->expanded())
+            {
+                // One rectangle per link body
+                const float linkHalfW = 0.5f * spikeProps.linkThicknessPx;
+                const float linkHalfH = 0.5f * spikeProps.chainLength / ctx->links.size();
+                for (EntityId link : ctx->links)
+                {
+                    const BodyPose linkPose = DrawPose(store, link);
+                    batch.rect({linkPose.x, linkPose.y}, {linkHalfW, linkHalfH}, linkPose.c, linkPose.s, DARKGRAY);
+                }
+            }
+
+            // Hook rectangle (plus the rope line while collapsed)
+            const BodyPose hookPose = DrawPose(store, ctx->hook);
+            if (!ctx->expanded())
+                batch.line(center, {hookPose.x, hookPose.y}, 3.0f, DARKGRAY);
+            Vector2 hookHalf = {ctx->halfW * spikeProps.hookScaleW, ctx->halfH * spikeProps.hookScaleH};
+            if (sdf)
+            {
+                batch.roundedBox({hookPose.x, hookPose.y}, hookHalf, visual.roundness, hookPose.c, hookPose.s,
+                                 visual.color);
+                batch.disc(center, r, visual.color);
+            }
+            else
+            {
+                batch.rect({hookPose.x, hookPose.y}, hookHalf, hookPose.c, hookPose.s, visual.color);
+                batch.circle(center, r, visual.color);
+            }
         }
         else
         {
             // Fallback simple render
-            if (e.spikeProps.chainLength > 0.0f)
+            if (spikeProps.chainLength > 0.0f)
             {
-                Vector2 chainTop = {center.x, center.y - e.spikeProps.chainLength};
-                DrawLineEx(chainTop, center, 3.0f, DARKGRAY);
+                Vector2 chainTop = {center.x, center.y - spikeProps.chainLength};
+                batch.line(chainTop, center, 3.0f, DARKGRAY);
             }
-            DrawCircleV(center, r, e.visual.color);
+            if (sdf)
+                batch.disc(center, r, visual.color);
+            else
+                batch.circle(center, r, visual.color);
         }
         break;
     }
     }
 }
 
-inline GameEntity makeEntity(
-    EntityManager &em,
+inline EntityId makeEntity(
+    ComponentStore &store,
     b2WorldId world,
-    const Texture &texture,
+    const Sprite &sprite,
     const b2Polygon &polygon,
     const b2Vec2 &extentPx,
     const b2Vec2 &posMeters,
     b2BodyType bodyType,
-    const PhysicsMaterial &physicsMat = PhysicsMaterial{})
+    const PhysicsMaterial &physicsMat = PhysicsMaterial{},
+    bool sensorEvents = false)
 {
 
     b2BodyDef def = b2DefaultBodyDef();
@@ -166,42 +182,49 @@ inline GameEntity makeEntity(
     def.angularDamping = physicsMat.angularDamping;
     def.gravityScale = physicsMat.affectedByGravity ? 1.0f : 0.0f;
 
-    GameEntity e{};
-    e.id = em.create();
-    e.body.id = b2CreateBody(world, &def);
-    e.sprite.texture = texture;
-    e.transform.extent = extentPx;
-    e.script.update = &DefaultUpdate;
-    e.script.render = &DefaultRender;
-    e.physics = physicsMat;
+    EntityId id = store.create();
+    PhysicsBody body{b2CreateBody(world, &def)};
+    store.add<PhysicsBody>(id, body);
+    store.add<Sprite>(id, sprite);
+    store.add<SpriteTransform>(id, SpriteTransform{extentPx});
+    Script script;
+    script.update = nullptr; // passive: skipped by UpdateScripts
+    script.render = &DefaultRender;
+    store.add<Script>(id, script);
+    store.add<VisualStyle>(id);
+    store.add<PhysicsMaterial>(id, physicsMat);
 
     b2ShapeDef sdef = b2DefaultShapeDef();
     sdef.density = physicsMat.density;
     sdef.material.friction = physicsMat.friction;
     sdef.material.restitution = physicsMat.restitution;
-    b2CreatePolygonShape(e.body.id, &sdef, &polygon);
+    sdef.enableSensorEvents = sensorEvents; // only capturable bodies are seen by spike sensors
+    b2CreatePolygonShape(body.id, &sdef, &polygon);
 
     // Apply gravity scale to the body (0 = no gravity, 1 = normal gravity)
-    b2Body_SetGravityScale(e.body.id, physicsMat.affectedByGravity ? 1.0f : 0.0f);
+    b2Body_SetGravityScale(body.id, physicsMat.affectedByGravity ? 1.0f : 0.0f);
+    store.pool<BodyPose>().track(id, body.id);
 
-    return e;
+    return id;
 }
 
-inline GameEntity makeGroundEntity(
-    EntityManager &em,
+inline EntityId makeGroundEntity(
+    ComponentStore &store,
     b2WorldId world,
-    const Texture &texture,
+    const Sprite &sprite,
     const b2Polygon &polygon,
     const b2Vec2 &extentPx,
     const b2Vec2 &posMeters)
 {
-    return makeEntity(em, world, texture, polygon, extentPx, posMeters, b2_staticBody);
+    EntityId id = makeEntity(store, world, sprite, polygon, extentPx, posMeters, b2_staticBody);
+    store.add<ObstacleTag>(id);
+    return id;
 }
 
-inline GameEntity makeBoxEntity(
-    EntityManager &em,
+inline EntityId makeBoxEntity(
+    ComponentStore &store,
     b2WorldId world,
-    const Texture &texture,
+    const Sprite &sprite,
     const b2Polygon &polygon,
     const b2Vec2 &extentPx,
     const b2Vec2 &posMeters,
@@ -209,47 +232,137 @@ inline GameEntity makeBoxEntity(
     const PhysicsMaterial &physicsMat = PhysicsMaterial{},
     const VisualStyle &visualStyle = VisualStyle{})
 {
-    auto e = makeEntity(em, world, texture, polygon, extentPx, posMeters, dynamic ? b2_dynamicBody : b2_staticBody, physicsMat);
-    e.visual = visualStyle;
-    return e;
+    EntityId id = makeEntity(store, world, sprite, polygon, extentPx, posMeters, dynamic ? b2_dynamicBody : b2_staticBody,
+                             physicsMat, true);
+    store.get<VisualStyle>(id) = visualStyle;
+    store.add<Impaled>(id);
+    store.add<BoxTag>(id);
+    return id;
+}
+
+// Physics material for thrown projectiles: light for snappier throws
+inline PhysicsMaterial ProjectileMaterial()
+{
+    PhysicsMaterial mat;
+    mat.density = 0.1f;
+    mat.friction = 0.4f;
+    mat.restitution = 0.3f;
+    mat.linearDamping = 0.1f;
+    mat.angularDamping = 0.1f;
+    mat.affectedByGravity = true;
+    return mat;
+}
+
+inline VisualStyle ProjectileVisual()
+{
+    VisualStyle visual;
+    visual.color = ORANGE;
+    visual.roundness = 0.2f;
+    visual.useTexture = true;
+    return visual;
+}
+
+// Pre-size the component pools a projectile uses so spawning up to `count` does not reallocate
+inline void reserveProjectiles(ComponentStore &store, std::size_t count)
+{
+    store.pool<PhysicsBody>().reserve(count);
+    store.pool<Sprite>().reserve(count);
+    store.pool<SpriteTransform>().reserve(count);
+    store.pool<Script>().reserve(count);
+    store.pool<VisualStyle>().reserve(count);
+    store.pool<PhysicsMaterial>().reserve(count);
+    store.pool<Impaled>().reserve(count);
+    store.pool<BoxTag>().reserve(count);
+    store.pool<Lifetime>().reserve(count);
+    store.pool<PooledBody>().reserve(count);
+}
+
+// Thrown box built around a body borrowed from the projectile pool
+inline EntityId makeProjectileEntity(
+    ComponentStore &store,
+    BodyPool &pool,
+    const Sprite &sprite,
+    const b2Vec2 &extentPx,
+    const b2Vec2 &posMeters)
+{
+    EntityId id = store.create();
+    PhysicsBody body{pool.acquire(posMeters)};
+    store.add<PhysicsBody>(id, body);
+    store.add<Sprite>(id, sprite);
+    store.add<SpriteTransform>(id, SpriteTransform{extentPx});
+    Script script;
+    script.update = nullptr; // passive: skipped by UpdateScripts
+    script.render = &DefaultRender;
+    store.add<Script>(id, script);
+    store.add<VisualStyle>(id, ProjectileVisual());
+    store.add<PhysicsMaterial>(id, ProjectileMaterial());
+    store.add<Impaled>(id);
+    store.add<BoxTag>(id);
+    store.add<Lifetime>(id);
+    store.add<PooledBody>(id, PooledBody{&pool});
+    store.pool<BodyPose>().track(id, body.id);
+    return id;
 }
 
 // Variable-sized static obstacle (box). Uses custom render.
-inline GameEntity makeObstacleEntity(
-    EntityManager &em,
+inline EntityId makeObstacleEntity(
+    ComponentStore &store,
     b2WorldId world,
     float unitsPerMeter,
     const b2Vec2 &extentPx,
     const b2Vec2 &posMeters,
-    const Texture &texture,
+    const Sprite &sprite,
     const VisualStyle &visualStyle = VisualStyle{{DARKGRAY}, 0.0f, false})
 {
     b2BodyDef def = b2DefaultBodyDef();
     def.type = b2_staticBody;
     def.position = posMeters;
-    GameEntity e{};
-    e.id = em.create();
-    e.body.id = b2CreateBody(world, &def);
-    e.transform.extent = extentPx;
-    e.sprite.texture = texture;
-    e.visual = visualStyle;
+    EntityId id = store.create();
+    PhysicsBody body{b2CreateBody(world, &def)};
+    store.add<PhysicsBody>(id, body);
+    store.add<SpriteTransform>(id, SpriteTransform{extentPx});
+    store.add<Sprite>(id, sprite);
+    store.add<VisualStyle>(id, visualStyle);
+    store.add<ObstacleTag>(id);
     // physics shape sized to extent
     b2Polygon poly = b2MakeBox(extentPx.x / unitsPerMeter, extentPx.y / unitsPerMeter);
     b2ShapeDef sdef = b2DefaultShapeDef();
-    b2CreatePolygonShape(e.body.id, &sdef, &poly);
-    e.script.update = &DefaultUpdate;
-    e.script.render = &ObstacleRender;
-    return e;
+    sdef.enableSensorEvents = false;
+    b2CreatePolygonShape(body.id, &sdef, &poly);
+    store.pool<BodyPose>().track(id, body.id);
+    Script script;
+    script.update = nullptr; // passive: skipped by UpdateScripts
+    script.render = &ObstacleRender;
+    store.add<Script>(id, script);
+    return id;
+}
+
+// Chain spike rope: distance joint between the spike and hook centers with no
+// spring and a maxLength clamp (behaves like a rope with slack)
+inline b2JointId makeChainRope(b2WorldId world, b2BodyId spike, b2BodyId hook, float lengthMeters)
+{
+    b2DistanceJointDef jdef = b2DefaultDistanceJointDef();
+    jdef.bodyIdA = spike;
+    jdef.bodyIdB = hook;
+    jdef.localAnchorA = {0.0f, 0.0f};
+    jdef.localAnchorB = {0.0f, 0.0f};
+    jdef.length = lengthMeters;    // nominal
+    jdef.minLength = 0.0f;         // allow slack
+    jdef.maxLength = lengthMeters; // rope limit
+    jdef.enableSpring = false;     // pure rope behavior
+    jdef.hertz = 0.0f;             // ignored when spring disabled
+    jdef.dampingRatio = 0.0f;      // ignored when spring disabled
+    return b2CreateDistanceJoint(world, &jdef);
 }
 
 // Spike hazard with customizable type and visual
-inline GameEntity makeSpikeEntity(
-    EntityManager &em,
+inline EntityId makeSpikeEntity(
+    ComponentStore &store,
     b2WorldId world,
     float unitsPerMeter,
     float radiusPx,
     const b2Vec2 &posMeters,
-    const Texture &texture,
+    const Sprite &sprite,
     const SpikeProperties &spikeProps = SpikeProperties{},
     const VisualStyle &visualStyle = VisualStyle{{RED}, 0.0f, false})
 {
@@ -257,48 +370,63 @@ inline GameEntity makeSpikeEntity(
     def.type = b2_dynamicBody; // Dynamic so joints work
     def.position = posMeters;
     def.gravityScale = 0.0f; // Zero gravity to keep spike stationary
-    GameEntity e{};
-    e.id = em.create();
-    e.body.id = b2CreateBody(world, &def);
-    e.transform.extent = {radiusPx, radiusPx};
-    e.sprite.texture = texture;
-    e.visual = visualStyle;
-    e.spikeProps = spikeProps;
+    EntityId id = store.create();
+    PhysicsBody body{b2CreateBody(world, &def)};
+    store.add<PhysicsBody>(id, body);
+    store.add<SpriteTransform>(id, SpriteTransform{{radiusPx, radiusPx}});
+    store.add<Sprite>(id, sprite);
+    store.add<VisualStyle>(id, visualStyle);
+    store.add<SpikeProperties>(id, spikeProps);
+    store.add<ImpaleCluster>(id);
+    if (spikeProps.type == SpikeType::SAW)
+        store.add<SawRotation>(id);
     // Create heavy static-like shape so spike doesn't move
     b2Polygon poly = b2MakeBox(radiusPx / unitsPerMeter, radiusPx / unitsPerMeter);
     b2ShapeDef sdef = b2DefaultShapeDef();
     sdef.density = 10000.0f; // Very heavy to resist movement
     sdef.material.friction = 1.0f;
+    sdef.enableSensorEvents = false;
     // If this is a chain spike and self-collide is disabled, keep anchor out of chain collisions
     if (spikeProps.type == SpikeType::CHAIN && !spikeProps.chainSelfCollide)
     {
         sdef.filter.groupIndex = -1;
     }
-    b2CreatePolygonShape(e.body.id, &sdef, &poly);
+    b2CreatePolygonShape(body.id, &sdef, &poly);
+
+    // Capture sensor: boxes entering it get impaled (see UpdateCapture); chain
+    // spikes with a hook capture at the hook instead. The 1.25 margin keeps the
+    // old radius check's easier collisions.
+    const bool hasHook = spikeProps.type == SpikeType::CHAIN && spikeProps.chainLength > 0.0f;
+    if (!hasHook)
+    {
+        b2Circle sensorCircle{{0.0f, 0.0f}, radiusPx / unitsPerMeter * 1.25f};
+        b2ShapeDef sensorDef = b2DefaultShapeDef();
+        sensorDef.isSensor = true;
+        sensorDef.enableSensorEvents = true;
+        sensorDef.density = 0.0f;
+        b2CreateCircleShape(body.id, &sensorDef, &sensorCircle);
+        store.add<CaptureZone>(id, CaptureZone{radiusPx * 1.25f});
+    }
 
     // Add high damping to prevent any movement
-    b2Body_SetLinearDamping(e.body.id, 100.0f);
-    b2Body_SetAngularDamping(e.body.id, 100.0f);
+    b2Body_SetLinearDamping(body.id, 100.0f);
+    b2Body_SetAngularDamping(body.id, 100.0f);
     // Optional: lock anchor rotation for extra stability
-    b2Body_SetFixedRotation(e.body.id, true);
+    b2Body_SetFixedRotation(body.id, true);
+    store.pool<BodyPose>().track(id, body.id);
 
-    e.script.update = &SpikeUpdate;
-    e.script.render = &SpikeRender;
+    Script script;
+    script.update = &SpikeUpdate;
+    script.render = &SpikeRender;
 
-    // If chain type, create only a rope (distance joint) and a rectangular hook
-    if (spikeProps.type == SpikeType::CHAIN && spikeProps.chainLength > 0.0f)
+    // If chain type, create a rope (distance joint) and a rectangular hook
+    if (hasHook)
     {
-        struct ChainContext
-        {
-            b2BodyId hookBody;
-            float halfW;
-            float halfH;
-        };
-        auto *ctx = new ChainContext{};
+        ChainContext chain;
         const float baseHalfW = spikeProps.linkThicknessPx * 0.5f; // reuse link dims as hook base
         const float baseHalfH = spikeProps.linkLengthPx * 0.5f;
-        ctx->halfW = baseHalfW;
-        ctx->halfH = baseHalfH;
+        chain.halfW = baseHalfW;
+        chain.halfH = baseHalfH;
 
         const float spikeHalfM = (radiusPx / unitsPerMeter);
         const float ropeLenM = (spikeProps.chainLength / unitsPerMeter);
@@ -310,67 +438,52 @@ inline GameEntity makeSpikeEntity(
         hdef.position = {anchorPos.x, anchorPos.y + spikeHalfM + ropeLenM};
         hdef.linearDamping = 0.6f;
         hdef.angularDamping = 0.8f;
-        ctx->hookBody = b2CreateBody(world, &hdef);
+        chain.hookBody = b2CreateBody(world, &hdef);
 
         // Hook rectangle shape
-        b2Polygon hpoly = b2MakeBox((ctx->halfW * spikeProps.hookScaleW) / unitsPerMeter,
-                                    (ctx->halfH * spikeProps.hookScaleH) / unitsPerMeter);
+        b2Polygon hpoly = b2MakeBox((chain.halfW * spikeProps.hookScaleW) / unitsPerMeter,
+                                    (chain.halfH * spikeProps.hookScaleH) / unitsPerMeter);
         b2ShapeDef hsdef = b2DefaultShapeDef();
         hsdef.density = std::max(spikeProps.linkDensity * 1.5f, 1.0f);
         hsdef.material.friction = spikeProps.linkFriction;
         hsdef.material.restitution = spikeProps.linkRestitution;
+        hsdef.enableSensorEvents = false;
         if (!spikeProps.chainSelfCollide)
             hsdef.filter.groupIndex = -1; // keep hook from colliding with spike
-        b2CreatePolygonShape(ctx->hookBody, &hsdef, &hpoly);
-
-        // Rope via distance joint, configured like the debug rope: center anchors,
-        // no spring, and a maxLength clamp (behaves like a rope with slack)
-        b2DistanceJointDef jdef = b2DefaultDistanceJointDef();
-        jdef.bodyIdA = e.body.id;
-        jdef.bodyIdB = ctx->hookBody;
-        jdef.localAnchorA = {0.0f, 0.0f};
-        jdef.localAnchorB = {0.0f, 0.0f};
-        jdef.length = ropeLenM;    // nominal
-        jdef.minLength = 0.0f;     // allow slack
-        jdef.maxLength = ropeLenM; // rope limit
-        jdef.enableSpring = false; // pure rope behavior
-        jdef.hertz = 0.0f;         // ignored when spring disabled
-        jdef.dampingRatio = 0.0f;  // ignored when spring disabled
-        b2CreateDistanceJoint(world, &jdef);
-
-        e.script.user = ctx;
-        e.script.freeFn = [](void *p)
-        { delete static_cast<ChainContext *>(p); };
+        b2CreatePolygonShape(chain.hookBody, &hsdef, &hpoly);
+
+        // Chain spikes capture at the hook: sensor radius is the hook's half diagonal
+        const float hookHalfW = chain.halfW * spikeProps.hookScaleW;
+        const float hookHalfH = chain.halfH * spikeProps.hookScaleH;
+        b2Circle hookSensor{{0.0f, 0.0f}, sqrtf(hookHalfW * hookHalfW + hookHalfH * hookHalfH) / unitsPerMeter * 1.25f};
+        b2ShapeDef hookSensorDef = b2DefaultShapeDef();
+        hookSensorDef.isSensor = true;
+        hookSensorDef.enableSensorEvents = true;
+        hookSensorDef.density = 0.0f;
+        b2CreateCircleShape(chain.hookBody, &hookSensorDef, &hookSensor);
+
+        // The hook is its own entity so its pose is cached like any other body
+        chain.hook = store.create();
+        store.add<PhysicsBody>(chain.hook, PhysicsBody{chain.hookBody});
+        store.add<ChainHook>(chain.hook, ChainHook{id});
+        store.add<ImpaleCluster>(chain.hook);
+        store.add<CaptureZone>(chain.hook, CaptureZone{hookSensor.radius * unitsPerMeter});
+        store.pool<BodyPose>().track(chain.hook, chain.hookBody);
+
+        // Starts collapsed: a single rope joint; the chain LOD system swaps in
+        // link bodies while the chain is visible and being hit
+        chain.rope = makeChainRope(world, body.id, chain.hookBody, ropeLenM);
+
+        store.add<ChainContext>(id, chain);
     }
-    return e;
+    store.add<Script>(id, script);
+    return id;
 }
 
 // Thrower: player-controlled launcher. Aims toward mouse, charges power by hold duration.
-struct ThrowerContext
+inline void ThrowerUpdate(ComponentStore &store, EntityId id, float dt)
 {
-    EntityManager *em{};
-    b2WorldId world{};
-    const Texture *boxTexture{};
-    b2Polygon boxPolygon{};
-    b2Vec2 boxExtentPx{};
-    float maxPower{300.0f};
-    float chargeRate{150.0f}; // power increase per second
-    float currentCharge{0.0f};
-    bool isCharging{false};
-    Vector2 aimDir{1.0f, 0.0f};             // normalized aim direction
-    std::vector<GameEntity> *projectiles{}; // destination container
-    float unitsPerMeter{50.0f};
-    float impulseMultiplier{8.0f};
-};
-
-inline void FreeThrowerCtx(void *p)
-{
-    delete static_cast<ThrowerContext *>(p);
-}
-
-inline void ThrowerUpdate(GameEntity &e, float dt)
-{
-    auto *ctx = static_cast<ThrowerContext *>(e.script.user);
+    ThrowerContext *ctx = store.tryGet<ThrowerContext>(id);
     if (!ctx)
         return;
 
@@ -383,58 +496,271 @@ inline void ThrowerUpdate(GameEntity &e, float dt)
     }
 }
 
-inline void ThrowerRender(const GameEntity &e, float unitsPerMeter)
+inline void ThrowerRender(const ComponentStore &store, EntityId id, float /*unitsPerMeter*/, SpriteBatch &batch)
 {
-    auto *ctx = static_cast<ThrowerContext *>(e.script.user);
-    DrawSolidBox(e, unitsPerMeter, ORANGE);
+    const ThrowerContext *ctx = store.tryGet<ThrowerContext>(id);
+    DrawSolidBox(store, id, batch, ORANGE);
 
     if (ctx && ctx->isCharging)
     {
-        // Draw aim line from thrower to mouse direction
-        b2Vec2 pos = b2Body_GetPosition(e.body.id);
-        Vector2 throwerScreen = {pos.x * unitsPerMeter, pos.y * unitsPerMeter};
+        // Aim line from thrower to mouse direction
+        const BodyPose pose = DrawPose(store, id);
+        Vector2 throwerScreen = {pose.x, pose.y};
         Vector2 aimEnd = {
             throwerScreen.x + ctx->aimDir.x * 200.0f,
             throwerScreen.y + ctx->aimDir.y * 200.0f};
-        DrawLineEx(throwerScreen, aimEnd, 3.0f, YELLOW);
+        batch.line(throwerScreen, aimEnd, 3.0f, YELLOW);
 
-        // Draw power indicator
+        // Power indicator
         float chargeRatio = ctx->currentCharge / ctx->maxPower;
         Color powerColor = chargeRatio < 0.5f ? YELLOW : (chargeRatio < 0.8f ? ORANGE : RED);
-        DrawCircle(throwerScreen.x, throwerScreen.y, 10.0f + chargeRatio * 15.0f, powerColor);
+        batch.circle(throwerScreen, 10.0f + chargeRatio * 15.0f, powerColor);
     }
 }
 
-inline GameEntity makeThrowerEntity(
-    EntityManager &em,
+inline EntityId makeThrowerEntity(
+    ComponentStore &store,
     b2WorldId world,
     float unitsPerMeter,
     const b2Vec2 &extentPx,
     const b2Vec2 &posMeters,
     float maxPower,
-    float impulseMultiplier,
-    const Texture &boxTexture,
-    const b2Polygon &boxPolygon,
-    const b2Vec2 &boxExtentPx,
-    std::vector<GameEntity> &projectiles)
+    float impulseMultiplier)
 {
     b2BodyDef def = b2DefaultBodyDef();
     def.type = b2_staticBody;
     def.position = posMeters;
-    GameEntity e{};
-    e.id = em.create();
-    e.body.id = b2CreateBody(world, &def);
-    e.transform.extent = extentPx;
+    EntityId id = store.create();
+    PhysicsBody body{b2CreateBody(world, &def)};
+    store.add<PhysicsBody>(id, body);
+    store.add<SpriteTransform>(id, SpriteTransform{extentPx});
+    store.add<ThrowerTag>(id);
     // Make thrower a sensor (non-colliding) so it doesn't block projectiles
     b2Polygon poly = b2MakeBox(extentPx.x / unitsPerMeter, extentPx.y / unitsPerMeter);
     b2ShapeDef sdef = b2DefaultShapeDef();
     sdef.isSensor = true;
-    b2CreatePolygonShape(e.body.id, &sdef, &poly);
+    sdef.enableSensorEvents = false; // not a capture sensor
+    b2CreatePolygonShape(body.id, &sdef, &poly);
+    store.pool<BodyPose>().track(id, body.id);
+    ThrowerContext thrower;
+    thrower.maxPower = maxPower;
+    thrower.impulseMultiplier = impulseMultiplier;
+    store.add<ThrowerContext>(id, thrower);
     // script hooks
-    auto *ctx = new ThrowerContext{&em, world, &boxTexture, boxPolygon, boxExtentPx, maxPower, 150.0f, 0.0f, false, {1.0f, 0.0f}, &projectiles, unitsPerMeter, impulseMultiplier};
-    e.script.user = ctx;
-    e.script.freeFn = &FreeThrowerCtx;
-    e.script.update = &ThrowerUpdate;
-    e.script.render = &ThrowerRender;
-    return e;
+    Script script;
+    script.update = &ThrowerUpdate;
+    script.render = &ThrowerRender;
+    store.add<Script>(id, script);
+    return id;
+}
+
+// Counterpart of the make*Entity factories: releases the impale joint, a chain
+// spike's hook entity and the Box2D body (back to its BodyPool if pooled), then
+// drops all components and recycles the id.
+inline void destroyEntity(ComponentStore &store, EntityId id)
+{
+    if (!store.isAlive(id))
+        return;
+
+    if (Impaled *impaled = store.tryGet<Impaled>(id))
+    {
+        if (impaled->hasJoint() && b2Joint_IsValid(impaled->jointId))
+            b2DestroyJoint(impaled->jointId);
+        impaled->jointId = b2_nullJointId;
+    }
+
+    if (ChainContext *chain = store.tryGet<ChainContext>(id))
+    {
+        std::vector<EntityId> links;
+        links.swap(chain->links);
+        const EntityId hook = chain->hook;
+        for (EntityId link : links)
+            destroyEntity(store, link);
+        destroyEntity(store, hook); // also destroys the rope joint
+    }
+
+    if (const MergedShape *merged = store.tryGet<MergedShape>(id))
+    {
+        if (b2Shape_IsValid(merged->shape))
+            b2DestroyShape(merged->shape, true);
+        if (B2_IS_NON_NULL(merged->parked) && b2Body_IsValid(merged->parked))
+            b2DestroyBody(merged->parked);
+    }
+
+    if (PhysicsBody *body = store.tryGet<PhysicsBody>(id))
+    {
+        const PooledBody *pooled = store.tryGet<PooledBody>(id);
+        if (pooled && pooled->pool)
+            pooled->pool->release(body->id);
+        else if (b2Body_IsValid(body->id))
+            b2DestroyBody(body->id);
+    }
+
+    store.destroy(id);
+}
+
+// Merge an impaled box into the body it hangs from (spike or chain hook): its
+// polygon is recreated on the anchor's body at the current relative transform,
+// then its joint goes away and its own body leaves the simulation (pooled
+// bodies back to their pool, others disabled and parked in MergedShape so a
+// WorldSnapshot taken before the merge can bring them back).
+// The entity keeps its other components; its pose now follows the anchor's
+// (see SyncMergedPoses). Returns false if the box cannot be merged.
+inline bool consolidateEntity(ComponentStore &store, EntityId id)
+{
+    Impaled *impaled = store.tryGet<Impaled>(id);
+    const PhysicsBody *body = store.tryGet<PhysicsBody>(id);
+    if (!impaled || !body || !b2Body_IsValid(body->id) || store.has<MergedShape>(id))
+        return false;
+    const PhysicsBody *anchorBody = store.tryGet<PhysicsBody>(impaled->anchor);
+    if (!anchorBody || !b2Body_IsValid(anchorBody->id))
+        return false;
+    b2ShapeId boxShape = b2_nullShapeId;
+    if (b2Body_GetShapes(body->id, &boxShape, 1) != 1 || b2Shape_GetType(boxShape) != b2_polygonShape)
+        return false;
+
+    // Box transform in the anchor's frame, in meters for the shape and pixels for the pose
+    const b2Transform local = b2InvMulTransforms(b2Body_GetTransform(anchorBody->id), b2Body_GetTransform(body->id));
+    const b2Polygon boxPolygon = b2Shape_GetPolygon(boxShape);
+    const b2Polygon polygon = b2TransformPolygon(local, &boxPolygon);
+    b2ShapeDef sdef = b2DefaultShapeDef();
+    sdef.density = b2Shape_GetDensity(boxShape);
+    sdef.material.friction = b2Shape_GetFriction(boxShape);
+    sdef.material.restitution = b2Shape_GetRestitution(boxShape);
+    sdef.filter = b2Shape_GetFilter(boxShape);
+    sdef.enableSensorEvents = false; // already captured
+
+    const PoseCache &poses = store.pool<BodyPose>();
+    const BodyPose a = poses.get(impaled->anchor);
+    const BodyPose b = poses.get(id);
+    const float dx = b.x - a.x;
+    const float dy = b.y - a.y;
+    MergedShape merged;
+    merged.anchor = impaled->anchor;
+    merged.shape = b2CreatePolygonShape(anchorBody->id, &sdef, &polygon);
+    merged.offset = {a.c * dx + a.s * dy, -a.s * dx + a.c * dy};
+    merged.rotation = {a.c * b.c + a.s * b.s, a.c * b.s - a.s * b.c};
+
+    if (impaled->hasJoint() && b2Joint_IsValid(impaled->jointId))
+        b2DestroyJoint(impaled->jointId);
+    impaled->jointId = b2_nullJointId;
+
+    const PooledBody *pooled = store.tryGet<PooledBody>(id);
+    if (pooled && pooled->pool)
+        pooled->pool->release(body->id);
+    else
+    {
+        b2Body_Disable(body->id);
+        merged.parked = body->id;
+    }
+    store.remove<PooledBody>(id);
+    store.remove<PhysicsBody>(id);
+    store.add<MergedShape>(id, merged);
+    return true;
+}
+
+// Links a chain spike is split into when expanded (about linkLengthPx each)
+inline int ChainLinkCount(const SpikeProperties &props)
+{
+    const float linkLength = props.linkLengthPx > 1.0f ? props.linkLengthPx : 1.0f;
+    const int count = static_cast<int>(ceilf(props.chainLength / linkLength));
+    return std::min(std::max(count, 2), 64);
+}
+
+// Replace a chain spike's rope joint with link bodies (SpikeProperties link
+// settings) laid along the current spike -> hook line, joined by revolute
+// joints from the spike center to the hook center. Links are entities
+// (PhysicsBody, ChainLink, BodyPose), so they draw interpolated and show up in
+// the spatial grid. Creates bodies and entities: call at a sync point only.
+inline bool expandChain(ComponentStore &store, b2WorldId world, float unitsPerMeter, EntityId spike)
+{
+    ChainContext *chain = store.tryGet<ChainContext>(spike);
+    if (!chain || chain->expanded() || !b2Body_IsValid(chain->hookBody))
+        return false;
+    const SpikeProperties &props = store.get<SpikeProperties>(spike);
+    const b2BodyId spikeBody = store.get<PhysicsBody>(spike).id;
+    PoseCache &poses = store.pool<BodyPose>();
+    const BodyPose a = poses.get(spike);
+    const BodyPose h = poses.get(chain->hook);
+    const float dx = h.x - a.x;
+    const float dy = h.y - a.y;
+    const float dist = sqrtf(dx * dx + dy * dy);
+    if (dist < 1.0f)
+        return false;
+
+    // Links keep their nominal length; pivots are spaced along the current
+    // line, which matches it when the rope is taut
+    const int count = ChainLinkCount(props);
+    const float linkHalfM = 0.5f * props.chainLength / count / unitsPerMeter;
+    const b2Vec2 dir = {dx / dist, dy / dist};
+    const float spacing = dist / count;
+    const b2Vec2 hookVelocity = b2Body_GetLinearVelocity(chain->hookBody);
+
+    b2Polygon poly = b2MakeBox(0.5f * props.linkThicknessPx / unitsPerMeter, linkHalfM);
+    b2ShapeDef sdef = b2DefaultShapeDef();
+    sdef.density = std::max(props.linkDensity, 0.5f); // massless links would not swing
+    sdef.material.friction = props.linkFriction;
+    sdef.material.restitution = props.linkRestitution;
+    sdef.enableSensorEvents = false;
+    if (!props.chainSelfCollide)
+        sdef.filter.groupIndex = -1; // same group as the spike and hook
+
+    b2BodyDef def = b2DefaultBodyDef();
+    def.type = b2_dynamicBody;
+    def.rotation = {dir.y, -dir.x}; // link's long (local y) axis along the line
+    def.linearDamping = 0.6f;
+    def.angularDamping = 0.8f;
+
+    b2RevoluteJointDef jdef = b2DefaultRevoluteJointDef();
+    jdef.bodyIdA = spikeBody;
+    jdef.localAnchorA = {0.0f, 0.0f};
+    chain->links.reserve(count);
+    for (int i = 0; i < count; ++i)
+    {
+        const float t = (i + 0.5f) / count; // fraction of the way to the hook
+        def.position = {(a.x + dir.x * spacing * (i + 0.5f)) / unitsPerMeter,
+                        (a.y + dir.y * spacing * (i + 0.5f)) / unitsPerMeter};
+        def.linearVelocity = {hookVelocity.x * t, hookVelocity.y * t};
+        const b2BodyId linkBody = b2CreateBody(world, &def);
+        b2CreatePolygonShape(linkBody, &sdef, &poly);
+
+        jdef.bodyIdB = linkBody;
+        jdef.localAnchorB = {0.0f, -linkHalfM};
+        b2CreateRevoluteJoint(world, &jdef);
+        jdef.bodyIdA = linkBody;
+        jdef.localAnchorA = {0.0f, linkHalfM};
+
+        const EntityId link = store.create();
+        store.add<PhysicsBody>(link, PhysicsBody{linkBody});
+        store.add<ChainLink>(link, ChainLink{spike});
+        poses.track(link, linkBody);
+        chain->links.push_back(link);
+    }
+    jdef.bodyIdB = chain->hookBody;
+    jdef.localAnchorB = {0.0f, 0.0f};
+    b2CreateRevoluteJoint(world, &jdef);
+
+    if (B2_IS_NON_NULL(chain->rope) && b2Joint_IsValid(chain->rope))
+        b2DestroyJoint(chain->rope);
+    chain->rope = b2_nullJointId;
+    chain->restTime = 0.0f;
+    return true;
+}
+
+// Back to the single rope joint: destroy the link entities (their joints go
+// with their bodies) and hang the hook on a new rope. Sync point only.
+inline bool collapseChain(ComponentStore &store, b2WorldId world, float unitsPerMeter, EntityId spike)
+{
+    ChainContext *chain = store.tryGet<ChainContext>(spike);
+    if (!chain || !chain->expanded())
+        return false;
+    std::vector<EntityId> links;
+    links.swap(chain->links);
+    for (EntityId link : links)
+        destroyEntity(store, link);
+
+    const float ropeLenM = store.get<SpikeProperties>(spike).chainLength / unitsPerMeter;
+    chain->rope = makeChainRope(world, store.get<PhysicsBody>(spike).id, chain->hookBody, ropeLenM);
+    chain->restTime = 0.0f;
+    return true;
 }
@@ -8,18 +8,41 @@
 #include "../components/visual_style.hpp"
 #include "../components/physics_material.hpp"
 #include "../components/spike_properties.hpp"
+#include "../components/tags.hpp"
+#include "../components/lifetime.hpp"
+#include "../components/pooled_body.hpp"
+#include "../components/chain_context.hpp"
+#include "../components/thrower_context.hpp"
+#include "../components/saw_rotation.hpp"
+#include "../components/impale_cluster.hpp"
+#include "../components/merged_shape.hpp"
+#include "../components/capture_zone.hpp"
 #include "../core/entity_manager.hpp"
+#include "../core/component_store.hpp"
+#include "../core/pose_cache.hpp"
 
-// Aggregate type used before introducing a full EntityManager
-struct GameEntity
+// Entities are plain EntityIds; their data lives in per-component pools of the ComponentStore.
+// Every entity with a PhysicsBody also has a BodyPose (SoA pose cache, see pose_cache.hpp).
+// Component sets per category (see factory.hpp):
+// - box:      PhysicsBody, SpriteTransform, Sprite, Script, Impaled, VisualStyle, PhysicsMaterial, BoxTag
+//             (+ Lifetime and PooledBody when thrown: despawned by the lifetime system,
+//              body returned to the projectile BodyPool)
+//             Once consolidated: PhysicsBody/PooledBody replaced by MergedShape
+//             (shape on the spike's body, pose derived from the spike's)
+// - obstacle: PhysicsBody, SpriteTransform, Sprite, Script, VisualStyle, ObstacleTag
+// - spike:    PhysicsBody, SpriteTransform, Sprite, Script, VisualStyle, SpikeProperties, ImpaleCluster
+//             (+ ChainContext for chain spikes, SawRotation for saws, CaptureZone unless
+//              the chain hook captures)
+// - thrower:  PhysicsBody, SpriteTransform, Script, ThrowerTag, ThrowerContext
+// - hook:     PhysicsBody, ChainHook, ImpaleCluster, CaptureZone (chain spike hook, owned by its spike)
+// - link:     PhysicsBody, ChainLink (expanded chain spike link, owned by its spike)
+
+// Create every game component pool up front: pool<T>() creates lazily, which
+// is not safe once systems run concurrently
+inline void registerGamePools(ComponentStore &store)
 {
-    EntityId id; // stable entity id
-    PhysicsBody body;
-    SpriteTransform transform;
-    Sprite sprite;
-    Script script;              // per-entity logic/render hooks
-    Impaled impaled;            // spike collision state
-    VisualStyle visual;         // color, roundness, texture usage
-    PhysicsMaterial physics;    // density, friction, restitution, damping
-    SpikeProperties spikeProps; // spike-specific properties (type, rotation, etc)
-};
+    store.registerPools<PhysicsBody, SpriteTransform, Sprite, Script, Impaled, VisualStyle,
+                        PhysicsMaterial, SpikeProperties, BoxTag, ObstacleTag, ThrowerTag,
+                        Lifetime, PooledBody, ChainContext, ChainHook, ChainLink, ThrowerContext, SawRotation,
+                        ImpaleCluster, MergedShape, CaptureZone, BodyPose>();
+}
@@ -2,6 +2,8 @@
 
 #include "../components/advertisement.hpp"
 #include "camera_system.hpp"
+#include "sprite_batch.hpp"
+#include "../core/texture_atlas.hpp"
 #include "raylib.h"
 #include <toml.hpp>
 #include <vector>
@@ -41,6 +43,10 @@ public:
     // Renderiza com câmera (para anúncios em mundo/parallax)
     void RenderWithCamera(const GameCamera &camera);
 
+    // Envia os anúncios em mundo/parallax visíveis ao batch do frame (camada Ads, sobre
+    // o nível; coordenadas do mundo), agrupados por textura junto com as entidades
+    void SubmitWithCamera(const GameCamera &camera, SpriteBatch &batch);
+
     // Remove anúncios que estão longe da câmera (economiza memória)
     void CleanupOffscreenAds(const GameCamera &camera, float cleanupDistance = 2000.0f);
 
@@ -48,7 +54,12 @@ public:
     void GenerateParallaxAds(const std::string &templateAdId, float startX, float endX, float spacing);
 
     // Define a câmera para anúncios em mundo
-    void SetCamera(GameCamera *camera) { camera_ = camera; } // Gerenciamento
+    void SetCamera(GameCamera *camera) { camera_ = camera; }
+
+    // Atlas consultado por LoadLocalTexture (antes de LoadFromTOML)
+    void SetAtlas(const TextureAtlas *atlas) { atlas_ = atlas; }
+
+    // Gerenciamento
     void ActivateAd(const std::string &id);
     void DeactivateAd(const std::string &id);
     void ToggleAd(const std::string &id);
@@ -66,9 +77,19 @@ public:
 
 private:
     std::vector<Advertisement> ads_;
+    std::vector<Advertisement> pendingAds_; // staged by GenerateParallaxAds, merged at the start of Update
     Config config_;
     std::ofstream logStream_;
     GameCamera *camera_ = nullptr; // Referência para a câmera do jogo
+    const TextureAtlas *atlas_ = nullptr; // Criativos empacotados (opcional)
+
+    // Região da textura a desenhar: a do atlas, ou a textura/frame inteiro
+    static Rectangle SourceRect(const Advertisement &ad, const Texture &texture)
+    {
+        if (&texture == &ad.texture && ad.textureRect.width > 0)
+            return ad.textureRect;
+        return {0, 0, (float)texture.width, (float)texture.height};
+    }
 
     // Helpers de carregamento
     bool LoadLocalTexture(Advertisement &ad);
@@ -291,6 +312,13 @@ inline bool AdvertisementSystem::LoadFromTOML(const std::string &tomlPath)
 
 inline void AdvertisementSystem::Update(float deltaTime)
 {
+    // Anúncios gerados entram aqui, nunca durante uma iteração de ads_
+    if (!pendingAds_.empty())
+    {
+        ads_.insert(ads_.end(), pendingAds_.begin(), pendingAds_.end());
+        pendingAds_.clear();
+    }
+
     for (auto &ad : ads_)
     {
         if (!ad.active)
@@ -356,7 +384,7 @@ inline void AdvertisementSystem::Render()
             // Renderiza textura estática
             DrawTexturePro(
                 ad.texture,
-                {0, 0, (float)ad.texture.width, (float)ad.texture.height},
+                SourceRect(ad, ad.texture),
                 ad.bounds,
                 {0, 0},
                 ad.rotation,
@@ -374,16 +402,26 @@ inline void AdvertisementSystem::Render()
 }
 
 inline void AdvertisementSystem::RenderWithCamera(const GameCamera &camera)
+{
+    SpriteBatch batch;
+    SubmitWithCamera(camera, batch);
+    BeginMode2D(camera.ToCamera2D());
+    batch.draw();
+    EndMode2D();
+}
+
+inline void AdvertisementSystem::SubmitWithCamera(const GameCamera &camera, SpriteBatch &batch)
 {
     // Mapa para contar anúncios visíveis por sponsor (para agrupar anúncios do mesmo tipo)
     std::map<std::string, int> visibleCountPerSponsor;
+    batch.setLayer(RenderLayer::Ads);
 
     for (const auto &ad : ads_)
     {
         if (!ad.active || !ad.loaded)
             continue;
 
-        // Renderiza apenas anúncios em mundo/parallax
+        // Apenas anúncios em mundo/parallax
         if (ad.placementMode == AdPlacementMode::FIXED_SCREEN)
             continue;
 
@@ -392,139 +430,77 @@ inline void AdvertisementSystem::RenderWithCamera(const GameCamera &camera)
         if (currentCount >= ad.maxVisible)
             continue;
 
-        // Calcula posição na tela baseado no modo
-        Vector2 screenPos;
-        if (ad.placementMode == AdPlacementMode::PARALLAX_BACKGROUND)
-        {
-            // Aplica parallax
-            Vector2 parallaxPos = camera.ApplyParallax(ad.worldPosition, ad.parallaxFactor);
-            screenPos = camera.WorldToScreen(parallaxPos);
+        // Posição no mundo: parallax aplicado antes da câmera, ou posição fixa
+        // no mundo; o lote é desenhado através da câmera (BeginMode2D)
+        Vector2 worldPos = ad.placementMode == AdPlacementMode::PARALLAX_BACKGROUND
+                               ? camera.ApplyParallax(ad.worldPosition, ad.parallaxFactor)
+                               : ad.worldPosition;
 
-            Rectangle screenRect = {
-                screenPos.x,
-                screenPos.y,
-                ad.bounds.width,
-                ad.bounds.height};
+        Rectangle worldRect = {
+            worldPos.x,
+            worldPos.y,
+            ad.bounds.width,
+            ad.bounds.height};
 
-            // Só renderiza se estiver visível
-            if (!CheckCollisionRecs(screenRect, camera.viewport))
-                continue;
+        // Só envia se estiver visível (zoom e rotação incluídos)
+        if (!camera.IsRectVisible(worldRect))
+            continue;
 
-            // Incrementa contador global para este tipo de anúncio
-            visibleCountPerSponsor[ad.sponsor]++;
+        // Incrementa contador global para este tipo de anúncio
+        visibleCountPerSponsor[ad.sponsor]++;
 
-            Color tintWithOpacity = ad.tint;
-            tintWithOpacity.a = (unsigned char)(ad.opacity * 255);
+        Color tintWithOpacity = ad.tint;
+        tintWithOpacity.a = (unsigned char)(ad.opacity * 255);
 
-            if (ad.type == AdType::ANIMATED_GIF && ad.frames != nullptr)
-            {
-                DrawTexturePro(
-                    ad.frames[ad.currentFrame],
-                    {0, 0, (float)ad.frames[ad.currentFrame].width, (float)ad.frames[ad.currentFrame].height},
-                    screenRect,
-                    {0, 0},
-                    ad.rotation,
-                    tintWithOpacity);
-            }
-            else
-            {
-                DrawTexturePro(
-                    ad.texture,
-                    {0, 0, (float)ad.texture.width, (float)ad.texture.height},
-                    screenRect,
-                    {0, 0},
-                    ad.rotation,
-                    tintWithOpacity);
-            }
+        const Texture &texture =
+            (ad.type == AdType::ANIMATED_GIF && ad.frames != nullptr) ? ad.frames[ad.currentFrame] : ad.texture;
+        batch.sprite(texture,
+                     SourceRect(ad, texture),
+                     worldRect,
+                     {0, 0},
+                     ad.rotation,
+                     tintWithOpacity);
 
 #ifdef DEBUG
-            if (ad.clickable)
-            {
-                DrawRectangleLinesEx(screenRect, 1, GREEN);
-            }
-#endif
-        }
-        else // WORLD_SPACE
+        if (ad.clickable)
         {
-            // Posição fixa no mundo
-            screenPos = camera.WorldToScreen(ad.worldPosition);
-
-            Rectangle screenRect = {
-                screenPos.x,
-                screenPos.y,
-                ad.bounds.width,
-                ad.bounds.height};
-
-            if (!CheckCollisionRecs(screenRect, camera.viewport))
-                continue;
-
-            // Incrementa contador global
-            visibleCountPerSponsor[ad.sponsor]++;
-
-            Color tintWithOpacity = ad.tint;
-            tintWithOpacity.a = (unsigned char)(ad.opacity * 255);
-
-            if (ad.type == AdType::ANIMATED_GIF && ad.frames != nullptr)
-            {
-                DrawTexturePro(
-                    ad.frames[ad.currentFrame],
-                    {0, 0, (float)ad.frames[ad.currentFrame].width, (float)ad.frames[ad.currentFrame].height},
-                    screenRect,
-                    {0, 0},
-                    ad.rotation,
-                    tintWithOpacity);
-            }
-            else
-            {
-                DrawTexturePro(
-                    ad.texture,
-                    {0, 0, (float)ad.texture.width, (float)ad.texture.height},
-                    screenRect,
-                    {0, 0},
-                    ad.rotation,
-                    tintWithOpacity);
-            }
-
-#ifdef DEBUG
-            if (ad.clickable)
-            {
-                DrawRectangleLinesEx(screenRect, 1, GREEN);
-            }
-#endif
+            Vector2 tl = {worldRect.x, worldRect.y};
+            Vector2 tr = {worldRect.x + worldRect.width, worldRect.y};
+            Vector2 br = {worldRect.x + worldRect.width, worldRect.y + worldRect.height};
+            Vector2 bl = {worldRect.x, worldRect.y + worldRect.height};
+            batch.line(tl, tr, 1.0f, GREEN);
+            batch.line(tr, br, 1.0f, GREEN);
+            batch.line(br, bl, 1.0f, GREEN);
+            batch.line(bl, tl, 1.0f, GREEN);
         }
+#endif
     }
 }
 
 inline void AdvertisementSystem::GenerateParallaxAds(const std::string &templateAdId, float startX, float endX, float spacing)
 {
-    // Encontra o template
-    Advertisement *templateAd = nullptr;
-    for (auto &ad : ads_)
-    {
-        if (ad.id == templateAdId)
-        {
-            templateAd = &ad;
-            break;
-        }
-    }
+    // Encontra o template (cópia: ponteiros para ads_ não sobrevivem a um push_back)
+    auto it = std::find_if(ads_.begin(), ads_.end(), [&](const Advertisement &ad)
+                           { return ad.id == templateAdId; });
 
-    if (!templateAd || !templateAd->loaded)
+    if (it == ads_.end() || !it->loaded)
     {
         TraceLog(LOG_WARNING, "Template ad '%s' not found or not loaded", templateAdId.c_str());
         return;
     }
+    const Advertisement templateAd = *it;
 
     // Gera anúncios ao longo da distância
     int count = 0;
     for (float x = startX; x <= endX; x += spacing)
     {
-        Advertisement newAd = *templateAd;
+        Advertisement newAd = templateAd;
         newAd.id = templateAdId + "_parallax_" + std::to_string(count);
-        newAd.worldPosition = {x, templateAd->worldPosition.y};
+        newAd.worldPosition = {x, templateAd.worldPosition.y};
         newAd.active = true;
         newAd.impressions = 0;
 
-        ads_.push_back(newAd);
+        pendingAds_.push_back(newAd);
         count++;
     }
 
@@ -618,7 +594,7 @@ inline void AdvertisementSystem::Cleanup()
 {
     for (auto &ad : ads_)
     {
-        if (ad.texture.id > 0)
+        if (ad.texture.id > 0 && !ad.atlasTexture)
         {
             UnloadTexture(ad.texture);
         }
@@ -647,6 +623,15 @@ inline bool AdvertisementSystem::LoadLocalTexture(Advertisement &ad)
 {
     std::string fullPath = ad.assetPath;
 
+    // Criativo empacotado no atlas: usa a região da página
+    if (const Sprite *region = atlas_ ? atlas_->find(fullPath) : nullptr)
+    {
+        ad.texture = region->texture;
+        ad.textureRect = region->source;
+        ad.atlasTexture = true;
+        return true;
+    }
+
     if (FileExists(fullPath.c_str()))
     {
         ad.texture = LoadTexture(fullPath.c_str());
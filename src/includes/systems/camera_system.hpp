@@ -2,10 +2,12 @@
 
 #include "raylib.h"
 
+#include <cmath>
+
 // Sistema de câmera para controlar viewport e parallax
 struct GameCamera
 {
-    Vector2 position;   // Posição da câmera no mundo
+    Vector2 position;   // Ponto do mundo mostrado em offset (pixels do mundo)
     Vector2 offset;     // Offset da câmera (geralmente centro da tela)
     float zoom;         // Zoom da câmera
     float rotation;     // Rotação da câmera
@@ -16,32 +18,58 @@ struct GameCamera
     {
     }
 
-    // Converte posição do mundo para posição na tela
+    // Converte posição do mundo para posição na tela (mesma transformação do
+    // Camera2D de ToCamera2D: translada, escala, rotaciona em torno de offset)
     Vector2 WorldToScreen(Vector2 worldPos) const
     {
-        return {
-            (worldPos.x - position.x) * zoom + offset.x,
-            (worldPos.y - position.y) * zoom + offset.y};
+        const float c = cosf(DEG2RAD * rotation);
+        const float s = sinf(DEG2RAD * rotation);
+        const float x = (worldPos.x - position.x) * zoom;
+        const float y = (worldPos.y - position.y) * zoom;
+        return {x * c - y * s + offset.x, x * s + y * c + offset.y};
     }
 
     // Converte posição da tela para posição no mundo
     Vector2 ScreenToWorld(Vector2 screenPos) const
     {
-        return {
-            (screenPos.x - offset.x) / zoom + position.x,
-            (screenPos.y - offset.y) / zoom + position.y};
+        const float c = cosf(DEG2RAD * rotation);
+        const float s = sinf(DEG2RAD * rotation);
+        const float x = screenPos.x - offset.x;
+        const float y = screenPos.y - offset.y;
+        return {(x * c + y * s) / zoom + position.x, (-x * s + y * c) / zoom + position.y};
+    }
+
+    // Câmera do raylib equivalente, para BeginMode2D
+    Camera2D ToCamera2D() const
+    {
+        return {offset, position, rotation, zoom};
+    }
+
+    // Retângulo do mundo que contém tudo o que aparece no viewport
+    // (com zoom e rotação: a caixa alinhada aos eixos dos quatro cantos)
+    Rectangle ViewBounds() const
+    {
+        const Vector2 corners[4] = {
+            ScreenToWorld({viewport.x, viewport.y}),
+            ScreenToWorld({viewport.x + viewport.width, viewport.y}),
+            ScreenToWorld({viewport.x, viewport.y + viewport.height}),
+            ScreenToWorld({viewport.x + viewport.width, viewport.y + viewport.height})};
+        float minX = corners[0].x, maxX = corners[0].x;
+        float minY = corners[0].y, maxY = corners[0].y;
+        for (const Vector2 &p : corners)
+        {
+            minX = fminf(minX, p.x);
+            maxX = fmaxf(maxX, p.x);
+            minY = fminf(minY, p.y);
+            maxY = fmaxf(maxY, p.y);
+        }
+        return {minX, minY, maxX - minX, maxY - minY};
     }
 
     // Verifica se um retângulo no mundo está visível
     bool IsRectVisible(Rectangle worldRect) const
     {
-        Rectangle screenRect = {
-            worldRect.x - position.x,
-            worldRect.y - position.y,
-            worldRect.width,
-            worldRect.height};
-
-        return CheckCollisionRecs(screenRect, viewport);
+        return CheckCollisionRecs(worldRect, ViewBounds());
     }
 
     // Aplica parallax a uma posição
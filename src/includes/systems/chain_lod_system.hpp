@@ -0,0 +1,111 @@
+#pragma once
+#include "raylib.h"
+#include "box2d/box2d.h"
+
+#include "../entities/types.hpp"
+#include "../entities/factory.hpp"
+#include "../core/spatial_grid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+// Context for the chain spike level of detail
+struct ChainLodContext
+{
+    ComponentStore &store;
+    b2WorldId worldId;
+    float lengthUnitsPerMeter;
+    const SpatialGrid *grid{nullptr}; // awake boxes near the rope count as hits
+    Rectangle view{};                 // visible world region (pixels)
+    bool enabled{true};               // off: every chain stays expanded
+    float viewMargin{200.0f};         // pixels around the view still counted as visible
+    float restDelay{1.0f};            // seconds at rest before an expanded chain collapses
+    float hitRadius{48.0f};           // pixels around the rope searched for incoming boxes
+    float tautRatio{0.95f};           // expand only with the hook at least this far out
+    std::vector<EntityId> nearby{};                    // grid query scratch
+    std::vector<std::pair<EntityId, bool>> switches{}; // (spike, expand) decided this tick
+};
+
+// Chain spikes hang their hook on a single rope joint by default. A chain is
+// expanded into link bodies (expandChain) when it is on screen and being hit,
+// i.e. an awake box is within hitRadius of the rope. The hook moving is not a
+// trigger on its own, since collapsing wakes it. An expanded chain collapses
+// back (collapseChain) once it leaves the view or its links and hook stay
+// asleep for restDelay. Expansion waits for a taut rope so the links start
+// where the rope was. Creates and destroys bodies and entities, so it runs as
+// an exclusive system after the flush.
+inline void UpdateChainLod(ChainLodContext &ctx, float deltaTime)
+{
+    ComponentStore &store = ctx.store;
+    const PoseCache &poses = store.pool<BodyPose>();
+    ctx.switches.clear();
+
+    auto decide = [&](EntityId spike, ChainContext &chain, const SpikeProperties &props)
+    {
+        const BodyPose a = poses.get(spike);
+        const BodyPose h = poses.get(chain.hook);
+        const float pad = ctx.viewMargin + props.linkThicknessPx;
+        const Rectangle bounds = {std::min(a.x, h.x) - pad, std::min(a.y, h.y) - pad,
+                                  fabsf(h.x - a.x) + 2.0f * pad, fabsf(h.y - a.y) + 2.0f * pad};
+        const bool visible = CheckCollisionRecs(bounds, ctx.view);
+
+        if (chain.expanded())
+        {
+            if (!ctx.enabled)
+                return; // LOD off: stay expanded
+
+            bool active = poses.isAwake(chain.hook);
+            for (std::size_t i = 0; i < chain.links.size() && !active; ++i)
+                active = poses.isAwake(chain.links[i]);
+            chain.restTime = active ? 0.0f : chain.restTime + deltaTime;
+            if (!visible || chain.restTime >= ctx.restDelay)
+                ctx.switches.emplace_back(spike, false);
+            return;
+        }
+
+        const float dx = h.x - a.x;
+        const float dy = h.y - a.y;
+        const bool taut = dx * dx + dy * dy >= (props.chainLength * ctx.tautRatio) * (props.chainLength * ctx.tautRatio);
+        if (!taut)
+            return;
+        if (!ctx.enabled)
+        {
+            ctx.switches.emplace_back(spike, true);
+            return;
+        }
+        if (!visible)
+            return;
+
+        // Without a grid, fall back to the hook being in motion
+        bool hit = !ctx.grid && poses.isAwake(chain.hook);
+        if (ctx.grid)
+        {
+            // Piles and ground strips can fill the capsule: grow to fit every match
+            ctx.nearby.resize(std::max<std::size_t>(ctx.nearby.capacity(), 64));
+            std::size_t found = ctx.grid->querySegment(a.x, a.y, h.x, h.y, ctx.hitRadius,
+                                                       ctx.nearby.data(), ctx.nearby.size());
+            if (found > ctx.nearby.size())
+            {
+                ctx.nearby.resize(found);
+                found = ctx.grid->querySegment(a.x, a.y, h.x, h.y, ctx.hitRadius, ctx.nearby.data(),
+                                               ctx.nearby.size());
+            }
+            for (std::size_t i = 0; i < std::min(found, ctx.nearby.size()) && !hit; ++i)
+                hit = store.has<BoxTag>(ctx.nearby[i]) && poses.isAwake(ctx.nearby[i]);
+        }
+        if (hit)
+            ctx.switches.emplace_back(spike, true);
+    };
+    store.view<ChainContext, SpikeProperties>().each(decide);
+
+    // Applied after the walk: expanding and collapsing add and remove entities
+    for (const auto &[spike, expand] : ctx.switches)
+    {
+        if (expand)
+            expandChain(store, ctx.worldId, ctx.lengthUnitsPerMeter, spike);
+        else
+            collapseChain(store, ctx.worldId, ctx.lengthUnitsPerMeter, spike);
+    }
+}
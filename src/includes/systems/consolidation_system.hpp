@@ -0,0 +1,82 @@
+#pragma once
+#include "box2d/box2d.h"
+
+#include "../entities/types.hpp"
+#include "../core/command_buffer.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Context for impaled stack consolidation
+struct ConsolidationContext
+{
+    ComponentStore &store;
+    CommandBuffer &commands;
+    bool enabled{true}; // off: every captured box keeps its own body and joint
+};
+
+// Boxes impaled on a spike each add a body and a joint to the solver. Once a
+// box hangs still (asleep per the last step), or when a spike holds more boxes
+// than its jointBudget, its shape is merged into the spike's (or hook's) body
+// at the flush (see consolidateEntity) and the joint goes away. Oldest boxes
+// merge first when over budget; boxes whose joint is still pending are skipped.
+// Reads: BodyPose, Impaled, MergedShape, SpikeProperties, ChainHook
+// Writes: ImpaleCluster, CommandBuffer
+inline void UpdateConsolidation(ConsolidationContext &ctx)
+{
+    ComponentStore &store = ctx.store;
+    const PoseCache &poses = store.pool<BodyPose>();
+
+    auto visit = [&](EntityId anchor, ImpaleCluster &cluster)
+    {
+        // Drop boxes that died or were merged since the last tick
+        std::vector<EntityId> &boxes = cluster.boxes;
+        boxes.erase(std::remove_if(boxes.begin(), boxes.end(), [&](EntityId box)
+                                   {
+                                       const Impaled *impaled = store.tryGet<Impaled>(box);
+                                       return !impaled || impaled->anchor != anchor || store.has<MergedShape>(box);
+                                   }),
+                    boxes.end());
+        if (!ctx.enabled || boxes.empty())
+            return;
+
+        // Chain hooks use their spike's budget
+        EntityId spike = anchor;
+        if (const ChainHook *hook = store.tryGet<ChainHook>(anchor))
+            spike = hook->spike;
+        const SpikeProperties *props = store.tryGet<SpikeProperties>(spike);
+        const std::size_t budget = (props && props->jointBudget > 0) ? static_cast<std::size_t>(props->jointBudget) : boxes.size();
+        const std::size_t excess = boxes.size() - std::min(budget, boxes.size());
+
+        for (std::size_t i = 0; i < boxes.size(); ++i)
+        {
+            const EntityId box = boxes[i];
+            if (!store.get<Impaled>(box).hasJoint())
+                continue; // captured this tick: joint created at the flush
+            if (i < excess || !poses.isAwake(box))
+                ctx.commands.consolidate(box);
+        }
+    };
+    store.view<ImpaleCluster>().each(visit);
+}
+
+// Merged boxes have no body of their own: after each refresh, boxes whose
+// anchor moved take the anchor's pose composed with their fixed offset.
+// Reads: MergedShape. Writes: BodyPose
+inline void SyncMergedPoses(ComponentStore &store)
+{
+    PoseCache &poses = store.pool<BodyPose>();
+    auto follow = [&](EntityId id, const MergedShape &merged)
+    {
+        if (!poses.hasMoved(merged.anchor))
+            return; // anchor settled (or gone): keep the last pose
+        const BodyPose anchor = poses.get(merged.anchor);
+        const b2Vec2 p = anchor.transformPoint(merged.offset);
+        const BodyPose pose{p.x, p.y,
+                            anchor.c * merged.rotation.c - anchor.s * merged.rotation.s,
+                            anchor.s * merged.rotation.c + anchor.c * merged.rotation.s};
+        poses.move(id, pose, poses.isAwake(merged.anchor));
+    };
+    store.view<MergedShape>().each(follow);
+}
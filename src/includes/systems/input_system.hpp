@@ -0,0 +1,55 @@
+#pragma once
+#include "raylib.h"
+
+#include "../core/input_trace.hpp"
+#include "camera_system.hpp"
+
+// Polls raylib once per frame into the input of the next simulation tick.
+// Button edges and key presses accumulate until a tick takes them, so frames
+// that run no tick lose nothing; the pointer is the latest position.
+// Main thread only.
+class InputSampler
+{
+public:
+    void poll()
+    {
+        pending.pointer = GetMousePosition();
+        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
+        {
+            pending.buttons |= TickInput::Press;
+            pending.press = pending.pointer;
+        }
+        if (IsMouseButtonReleased(MOUSE_LEFT_BUTTON))
+            pending.buttons |= TickInput::Release;
+
+        if (IsKeyPressed(KEY_P))
+            pending.actions |= TickInput::TogglePause;
+        if (IsKeyPressed(KEY_D))
+            pending.actions |= TickInput::ToggleDebug;
+        if (IsKeyPressed(KEY_C))
+            pending.actions |= TickInput::ToggleConsolidation;
+        if (IsKeyPressed(KEY_L))
+            pending.actions |= TickInput::ToggleChainLod;
+        if (IsKeyPressed(KEY_R))
+            pending.actions |= TickInput::Reset;
+        if (IsKeyPressed(KEY_F5))
+            pending.actions |= TickInput::QuickSave;
+        if (IsKeyPressed(KEY_F9))
+            pending.actions |= TickInput::QuickLoad;
+    }
+
+    // Input for the tick about to run, the pointer mapped into the world
+    // through the camera it runs with; edges and actions are consumed
+    TickInput take(const GameCamera &camera)
+    {
+        TickInput input = pending;
+        input.pointer = camera.ScreenToWorld(pending.pointer);
+        input.camera = camera.position;
+        pending.buttons = 0;
+        pending.actions = 0;
+        return input;
+    }
+
+private:
+    TickInput pending;
+};
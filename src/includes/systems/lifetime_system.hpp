@@ -0,0 +1,77 @@
+#pragma once
+#include "raylib.h"
+#include "box2d/box2d.h"
+
+#include "../entities/types.hpp"
+#include "../core/command_buffer.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+// Despawn rules for entities carrying a Lifetime component
+struct DespawnRules
+{
+    Rectangle bounds{-500.0f, -2000.0f, 2920.0f, 3580.0f}; // world pixels; leaving it despawns
+    float maxAge{30.0f};                                   // seconds (<= 0 disables)
+    std::size_t maxCount{256};                             // oldest despawn first (0 disables)
+    float settledImpaledTime{5.0f};                        // seconds impaled and asleep (<= 0 disables)
+};
+
+// Context for lifetime updates
+struct LifetimeContext
+{
+    ComponentStore &store;
+    CommandBuffer &commands;
+    DespawnRules rules;
+    std::vector<std::pair<float, EntityId>> survivors; // (age, id), reused every frame
+};
+
+// Age projectiles and record a destroy for the ones matching a rule.
+// Destruction is deferred to the command buffer flush, so the pools walked
+// here (and by any later system this frame) stay intact.
+inline void UpdateLifetime(LifetimeContext &ctx, float deltaTime)
+{
+    ComponentStore &store = ctx.store;
+    const DespawnRules &rules = ctx.rules;
+
+    ctx.survivors.clear();
+    const PoseCache &poses = store.pool<BodyPose>();
+    auto age = [&](EntityId id, Lifetime &life, const BodyPose &pose)
+    {
+        life.age += deltaTime;
+
+        bool expired = rules.maxAge > 0.0f && life.age >= rules.maxAge;
+
+        if (!expired)
+            expired = !CheckCollisionPointRec({pose.x, pose.y}, rules.bounds);
+
+        if (!expired && rules.settledImpaledTime > 0.0f)
+        {
+            const Impaled *impaled = store.tryGet<Impaled>(id);
+            if (impaled && impaled->frozen && !poses.isAwake(id)) // asleep per the last step's events
+                life.settledTime += deltaTime;
+            else
+                life.settledTime = 0.0f;
+            expired = life.settledTime >= rules.settledImpaledTime;
+        }
+
+        if (expired)
+            ctx.commands.destroy(id);
+        else
+            ctx.survivors.push_back({life.age, id});
+    };
+    store.view<Lifetime, const BodyPose>().each(age);
+
+    // Count cap: drop the oldest survivors
+    if (rules.maxCount > 0 && ctx.survivors.size() > rules.maxCount)
+    {
+        auto &survivors = ctx.survivors;
+        std::size_t excess = survivors.size() - rules.maxCount;
+        std::nth_element(survivors.begin(), survivors.begin() + excess, survivors.end(),
+                         [](const auto &a, const auto &b)
+                         { return a.first > b.first; });
+        for (std::size_t i = 0; i < excess; ++i)
+            ctx.commands.destroy(survivors[i].second);
+    }
+}
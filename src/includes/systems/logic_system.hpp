@@ -5,7 +5,13 @@
 #include "../entities/types.hpp"
 #include "../entities/factory.hpp"
 #include "../core/entity_manager.hpp"
+#include "../core/command_buffer.hpp"
+#include "../core/job_system.hpp"
+#include "../core/spatial_grid.hpp"
+#include "../core/input_trace.hpp"
+#include "consolidation_system.hpp"
 
+#include <algorithm>
 #include <vector>
 #include <cmath>
 
@@ -14,141 +20,286 @@ struct LogicContext
 {
     b2WorldId worldId;
     float lengthUnitsPerMeter;
-    std::vector<GameEntity> &boxes;
-    std::vector<GameEntity> &obstacles;
-    std::vector<GameEntity> &spikes;
-    std::vector<GameEntity> &throwers;
-    EntityManager &entityManager;
-    Texture &boxTexture;
+    ComponentStore &store;
+    BodyPool &projectilePool; // pre-created projectile bodies
+    CommandBuffer &commands;  // structural changes, flushed after all systems ran
+    Sprite &boxSprite;
     b2Polygon &boxPolygon;
     b2Vec2 &boxExtent;
     bool isPaused;
+    JobSystem *jobs{nullptr};   // optional: spreads the script pass over workers
+    SpatialGrid *grid{nullptr}; // optional: proximity index, synced after each step
+    int subSteps{4};            // Box2D sub-steps per fixed tick
+    uint32_t captures{0};       // boxes captured so far (sensor and swept)
 };
 
-// Main logic update: physics, collision, input, entity updates
-inline void UpdateLogic(LogicContext &ctx, float deltaTime)
+// UpdateLogic is split in stages so the scheduler can run them as separate
+// systems; the access each stage needs is listed above it.
+
+// Pixel pose -> meters
+inline b2Vec2 PoseToMeters(const LogicContext &ctx, const BodyPose &pose)
 {
+    const float invUnits = 1.0f / ctx.lengthUnitsPerMeter;
+    return b2Vec2{pose.x * invUnits, pose.y * invUnits};
+}
+
+// Runs once per fixed tick; deltaTime is the tick length (see FixedTimestep).
+// Reads: MergedShape. Writes: physics world, BodyPose, SpatialGrid
+inline void StepPhysics(LogicContext &ctx, float deltaTime)
+{
+    // Keep the pre-step poses for render interpolation (paused: previous ==
+    // current, so the drawn pose holds still)
+    PoseCache &poses = ctx.store.pool<BodyPose>();
+    poses.storePrevious();
     if (ctx.isPaused)
         return;
 
     // Step physics simulation
-    b2World_Step(ctx.worldId, deltaTime, 4);
+    b2World_Step(ctx.worldId, deltaTime, ctx.subSteps);
+
+    // Single pass over this step's body move events; everything after reads the cache
+    poses.refresh(ctx.worldId);
+    SyncMergedPoses(ctx.store);
+    if (ctx.grid)
+        ctx.grid->update(poses);
+}
+
+// Joint a free box to the spike (or chain hook) whose capture zone it touched.
+// boxPose is where the touch happened (pixels). The joint is recorded in the
+// command buffer and the box is frozen at once. False if targetId is no spike.
+inline bool CaptureBox(LogicContext &ctx, EntityId boxId, Impaled &impaled, EntityId targetId, const BodyPose &boxPose)
+{
+    ComponentStore &store = ctx.store;
+    const PoseCache &poses = store.pool<BodyPose>();
+    auto toMeters = [&ctx](const BodyPose &pose)
+    { return PoseToMeters(ctx, pose); };
+
+    // Target -> spike (a chain hook resolves to its spike)
+    EntityId spikeId = targetId;
+    if (const ChainHook *hook = store.tryGet<ChainHook>(targetId))
+        spikeId = hook->spike;
+    const SpikeProperties *spikeProps = store.tryGet<SpikeProperties>(spikeId);
+    if (!spikeProps)
+        return false;
 
-    // Check for box-spike collisions and attach/freeze on impact
-    for (auto &box : ctx.boxes)
+    // Body the joint attaches to: the hook for chain spikes, else the spike
+    const EntityId anchorId = spikeProps->type == SpikeType::CHAIN ? targetId : spikeId;
+    const b2BodyId boxBody = store.get<PhysicsBody>(boxId).id;
+    const SpriteTransform &boxTransform = store.get<SpriteTransform>(boxId);
+    b2Vec2 boxPos = toMeters(boxPose);
+    b2Vec2 targetPos = toMeters(poses.get(targetId));
+    float dx = boxPos.x - targetPos.x;
+    float dy = boxPos.y - targetPos.y;
+    float boxRadius = (boxTransform.extent.x + boxTransform.extent.y) * 0.5f / ctx.lengthUnitsPerMeter;
+
+    // Attachment behavior depends on spike type
+    switch (spikeProps->type)
+    {
+    case SpikeType::CHAIN:
     {
-        if (box.impaled.frozen || box.impaled.hasJoint())
-            continue; // already attached
+        // Create distance joint: box swings from the chain hook if available
+        b2DistanceJointDef jointDef = b2DefaultDistanceJointDef();
+        jointDef.bodyIdA = store.get<PhysicsBody>(anchorId).id;
+        jointDef.bodyIdB = boxBody;
+        jointDef.localAnchorA = {0.0f, 0.0f};      // spike center
+        jointDef.localAnchorB = {0.0f, 0.0f};      // box center
+        jointDef.length = sqrtf(dx * dx + dy * dy); // current distance
+        jointDef.minLength = 0.5f;                 // allow some slack
+        jointDef.maxLength = jointDef.length * 1.5f;
+        jointDef.hertz = spikeProps->jointHertz; // configurable stiffness
+        jointDef.dampingRatio = spikeProps->jointDamping;
+        ctx.commands.createJoint(boxId, jointDef);
+        break;
+    }
 
-        b2Vec2 boxPos = b2Body_GetPosition(box.body.id);
+    case SpikeType::SAW:
+    case SpikeType::NORMAL:
+    default:
+    {
+        // Create revolute joint for pendulum swing
+        b2RevoluteJointDef jointDef = b2DefaultRevoluteJointDef();
+        jointDef.bodyIdA = store.get<PhysicsBody>(anchorId).id;
+        jointDef.bodyIdB = boxBody;
+        jointDef.localAnchorA = {0.0f, 0.0f};
+        // Attach at box edge closest to spike
+        float angle = atan2f(dy, dx);
+        jointDef.localAnchorB = {-cosf(angle) * boxRadius, -sinf(angle) * boxRadius};
+        jointDef.enableLimit = false;
+        ctx.commands.createJoint(boxId, jointDef);
+        break;
+    }
+    }
+    impaled.frozen = true; // mark as captured now (first hit wins); the joint follows at the flush
+    impaled.anchor = anchorId;
+    ++ctx.captures;
+    if (ImpaleCluster *cluster = store.tryGet<ImpaleCluster>(anchorId))
+        cluster->boxes.push_back(boxId);
+    return true;
+}
 
-        for (const auto &spike : ctx.spikes)
-        {
-            // Determine target for collision depending on spike type
-            b2Vec2 targetPos = b2Body_GetPosition(spike.body.id);
-            float targetRadius = (spike.transform.extent.x + spike.transform.extent.y) * 0.5f / ctx.lengthUnitsPerMeter;
+// Swept capture for boxes that crossed a capture zone between two steps:
+// Box2D evaluates sensors at step end only, so a fast box can skip a small
+// spike without an event. Each free box that moved farther than its own size
+// this step has its path (previous -> current cached pose, the poses the
+// refresh just wrote) tested as a capsule against the CaptureZones; the zone
+// passed closest to, earliest along the path, captures it. The box is
+// teleported back to that point at the flush, before its joint is created.
+inline void SweepCapture(LogicContext &ctx)
+{
+    ComponentStore &store = ctx.store;
+    const PoseCache &poses = store.pool<BodyPose>();
+    const ComponentPool<CaptureZone> &zones = store.pool<CaptureZone>();
+    if (zones.empty())
+        return;
 
-            // For chain spikes, use the hook as the collision target
-            if (spike.spikeProps.type == SpikeType::CHAIN && spike.script.user)
-            {
-                struct ChainContext
-                {
-                    b2BodyId hookBody;
-                    float halfW;
-                    float halfH;
-                };
-                auto *spikeCtx = static_cast<ChainContext *>(spike.script.user);
-                if (spikeCtx)
-                {
-                    targetPos = b2Body_GetPosition(spikeCtx->hookBody);
-                    float hookHalfW = spikeCtx->halfW * spike.spikeProps.hookScaleW;
-                    float hookHalfH = spikeCtx->halfH * spike.spikeProps.hookScaleH;
-                    // approximate radius as half of diagonal
-                    float hookRadiusPx = sqrtf(hookHalfW * hookHalfW + hookHalfH * hookHalfH);
-                    targetRadius = hookRadiusPx / ctx.lengthUnitsPerMeter;
-                }
-            }
+    float maxZone = 0.0f;
+    for (const CaptureZone &zone : zones.data())
+        maxZone = std::max(maxZone, zone.radius);
 
-            float dx = boxPos.x - targetPos.x;
-            float dy = boxPos.y - targetPos.y;
-            float distSq = dx * dx + dy * dy;
+    constexpr std::size_t kMaxCandidates = 32;
+    EntityId candidates[kMaxCandidates];
+    for (EntityId boxId : poses.moved())
+    {
+        Impaled *impaled = store.tryGet<Impaled>(boxId);
+        if (!impaled || impaled->frozen || impaled->hasJoint() || !store.has<PhysicsBody>(boxId))
+            continue; // not a free box with a body of its own
 
-            // Check collision (simple radius check)
-            float boxRadius = (box.transform.extent.x + box.transform.extent.y) * 0.5f / ctx.lengthUnitsPerMeter;
-            float threshold = (targetRadius + boxRadius) * 1.25f; // Slight margin for easier collision
+        const BodyPose from = poses.previous(boxId);
+        const BodyPose to = poses.get(boxId);
+        const SpriteTransform &transform = store.get<SpriteTransform>(boxId);
+        const float boxRadius = 0.5f * (transform.extent.x + transform.extent.y);
+        const float dx = to.x - from.x;
+        const float dy = to.y - from.y;
+        const float len2 = dx * dx + dy * dy;
+        if (len2 <= boxRadius * boxRadius)
+            continue; // slow enough for the sensor to see it at a step boundary
 
-            if (distSq < threshold * threshold)
+        EntityId best{};
+        float bestT = 2.0f;
+        auto test = [&](EntityId zoneId)
+        {
+            const BodyPose c = poses.get(zoneId);
+            const float reach = zones.get(zoneId).radius + boxRadius;
+            float t = ((c.x - from.x) * dx + (c.y - from.y) * dy) / len2;
+            t = std::min(std::max(t, 0.0f), 1.0f);
+            const float ex = from.x + dx * t - c.x;
+            const float ey = from.y + dy * t - c.y;
+            if (ex * ex + ey * ey <= reach * reach && t < bestT)
             {
-                // Attachment behavior depends on spike type
-                switch (spike.spikeProps.type)
-                {
-                case SpikeType::CHAIN:
-                {
-                    // Create distance joint: box swings from the chain hook if available
-                    struct ChainContext
-                    {
-                        b2BodyId hookBody;
-                        float halfW;
-                        float halfH;
-                    };
-                    b2BodyId hook = spike.body.id;
-                    if (spike.script.user)
-                    {
-                        auto *spikeCtx = static_cast<ChainContext *>(spike.script.user);
-                        hook = spikeCtx->hookBody;
-                    }
-                    b2DistanceJointDef jointDef = b2DefaultDistanceJointDef();
-                    jointDef.bodyIdA = hook;
-                    jointDef.bodyIdB = box.body.id;
-                    jointDef.localAnchorA = {0.0f, 0.0f}; // spike center
-                    jointDef.localAnchorB = {0.0f, 0.0f}; // box center
-                    jointDef.length = sqrtf(distSq);      // current distance
-                    jointDef.minLength = 0.5f;            // allow some slack
-                    jointDef.maxLength = jointDef.length * 1.5f;
-                    jointDef.hertz = spike.spikeProps.jointHertz; // configurable stiffness
-                    jointDef.dampingRatio = spike.spikeProps.jointDamping;
-                    box.impaled.jointId = b2CreateDistanceJoint(ctx.worldId, &jointDef);
-                    box.impaled.frozen = true; // mark as captured
-                    break;
-                }
-
-                case SpikeType::SAW:
-                case SpikeType::NORMAL:
-                default:
-                {
-                    // Create revolute joint for pendulum swing
-                    b2RevoluteJointDef jointDef = b2DefaultRevoluteJointDef();
-                    jointDef.bodyIdA = spike.body.id;
-                    jointDef.bodyIdB = box.body.id;
-                    jointDef.localAnchorA = {0.0f, 0.0f};
-                    // Attach at box edge closest to spike
-                    float angle = atan2f(dy, dx);
-                    jointDef.localAnchorB = {-cosf(angle) * boxRadius, -sinf(angle) * boxRadius};
-                    jointDef.enableLimit = false;
-                    box.impaled.jointId = b2CreateRevoluteJoint(ctx.worldId, &jointDef);
-                    box.impaled.frozen = true;
-                    break;
-                }
-                }
-                break; // only attach to first spike hit
+                best = zoneId;
+                bestT = t;
+            }
+        };
+        // The grid holds every body, so a path through a pile or along the
+        // ground can return more hits than the buffer; the zone pool is then
+        // the shorter complete list
+        const std::size_t found = ctx.grid ? ctx.grid->querySegment(from.x, from.y, to.x, to.y, maxZone + boxRadius,
+                                                                    candidates, kMaxCandidates)
+                                           : 0;
+        if (ctx.grid && found <= kMaxCandidates)
+        {
+            for (std::size_t i = 0; i < found; ++i)
+            {
+                if (zones.has(candidates[i]))
+                    test(candidates[i]);
             }
         }
+        else
+        {
+            for (EntityId zoneId : zones.entities())
+                test(zoneId);
+        }
+        if (!best)
+            continue;
+
+        BodyPose hit = to;
+        hit.x = from.x + dx * bestT;
+        hit.y = from.y + dy * bestT;
+        if (CaptureBox(ctx, boxId, *impaled, best, hit))
+            ctx.commands.teleport(boxId, PoseToMeters(ctx, hit));
+    }
+}
+
+// Reads: physics world (sensor events), SpikeProperties, ChainHook, PhysicsBody, SpriteTransform,
+// BodyPose, CaptureZone
+// Writes: Impaled, ImpaleCluster, CommandBuffer
+inline void UpdateCapture(LogicContext &ctx)
+{
+    if (ctx.isPaused)
+        return;
+
+    ComponentStore &store = ctx.store;
+    const PoseCache &poses = store.pool<BodyPose>();
+
+    // Spikes and chain hooks carry sensor shapes; only boxes enable sensor events,
+    // so each begin event is a box touching a capture zone this step. Cost scales
+    // with touches, not with boxes x spikes. Events come in Box2D's deterministic order.
+    const b2SensorEvents events = b2World_GetSensorEvents(ctx.worldId);
+    for (int i = 0; i < events.beginCount; ++i)
+    {
+        const b2SensorBeginTouchEvent &touch = events.beginEvents[i];
+        if (!b2Shape_IsValid(touch.sensorShapeId) || !b2Shape_IsValid(touch.visitorShapeId))
+            continue; // shape destroyed since the step
+
+        // Visitor -> box that is still free
+        EntityId boxId = poses.entityOf(b2Shape_GetBody(touch.visitorShapeId));
+        Impaled *impaled = boxId ? store.tryGet<Impaled>(boxId) : nullptr;
+        if (!impaled || impaled->frozen || impaled->hasJoint())
+            continue; // not a box, or already attached
+
+        // Sensor -> spike or chain hook
+        EntityId targetId = poses.entityOf(b2Shape_GetBody(touch.sensorShapeId));
+        if (!targetId)
+            continue;
+        CaptureBox(ctx, boxId, *impaled, targetId, poses.get(boxId));
     }
 
+    // Boxes that tunneled through a sensor this step
+    SweepCapture(ctx);
+}
+
+// Record a projectile spawn from the thrower along its aimDir with its
+// currentCharge; shared by mouse input and scripted throws (batch runs).
+// Reads: BodyPose, ThrowerContext. Writes: CommandBuffer
+inline void FireThrower(LogicContext &ctx, EntityId throwerId, const ThrowerContext &thrower)
+{
+    const b2Vec2 throwerPos = PoseToMeters(ctx, ctx.store.pool<BodyPose>().get(throwerId));
+
+    // Apply impulse in aim direction
+    // Scale impulse to physics units (divide by lengthUnitsPerMeter to convert power from pixel-based to meter-based)
+    float impulseScale = (thrower.currentCharge / ctx.lengthUnitsPerMeter) * thrower.impulseMultiplier;
+    b2Vec2 impulse = {thrower.aimDir.x * impulseScale, thrower.aimDir.y * impulseScale};
+
+    // Spawn projectile at thrower position from the pre-created body pool (deferred)
+    ctx.commands.spawn(ProjectileSpawn{&ctx.projectilePool, ctx.boxSprite, ctx.boxExtent, throwerPos, impulse});
+}
+
+// Aim, charge and fire from one tick's input (live or replayed, see TickInput).
+// Reads: BodyPose. Writes: ThrowerContext, CommandBuffer
+inline void UpdateThrower(LogicContext &ctx, const TickInput &input)
+{
+    if (ctx.isPaused)
+        return;
+
+    ComponentStore &store = ctx.store;
+    const PoseCache &poses = store.pool<BodyPose>();
+    auto toMeters = [&ctx](const BodyPose &pose)
+    { return PoseToMeters(ctx, pose); };
+
     // Update thrower aim and charging
-    Vector2 mouseScreen = GetMousePosition();
+    const Vector2 aimTarget = input.pointer; // world pixels
 
-    if (!ctx.throwers.empty())
+    if (!store.pool<ThrowerTag>().empty())
     {
-        auto &thrower = ctx.throwers[0];
-        auto *throwerCtx = static_cast<ThrowerContext *>(thrower.script.user);
+        EntityId throwerId = store.pool<ThrowerTag>().entity(0);
+        ThrowerContext *throwerCtx = store.tryGet<ThrowerContext>(throwerId);
         if (throwerCtx)
         {
             // Calculate aim direction from thrower to mouse
-            b2Vec2 throwerPos = b2Body_GetPosition(thrower.body.id);
-            Vector2 throwerScreen = {throwerPos.x * ctx.lengthUnitsPerMeter, throwerPos.y * ctx.lengthUnitsPerMeter};
-            float dx = mouseScreen.x - throwerScreen.x;
-            float dy = mouseScreen.y - throwerScreen.y;
+            b2Vec2 throwerPos = toMeters(poses.get(throwerId));
+            Vector2 throwerPx = {throwerPos.x * ctx.lengthUnitsPerMeter, throwerPos.y * ctx.lengthUnitsPerMeter};
+            float dx = aimTarget.x - throwerPx.x;
+            float dy = aimTarget.y - throwerPx.y;
             float len = sqrtf(dx * dx + dy * dy);
             if (len > 1.0f)
             {
@@ -156,63 +307,61 @@ inline void UpdateLogic(LogicContext &ctx, float deltaTime)
             }
 
             // Handle charging (ThrowerUpdate handles the actual charge accumulation)
-            if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
+            if (input.pressed())
             {
                 throwerCtx->isCharging = true;
                 throwerCtx->currentCharge = 0.0f; // Reset charge at start
             }
 
-            if (throwerCtx->isCharging && IsMouseButtonReleased(MOUSE_LEFT_BUTTON))
+            if (throwerCtx->isCharging && input.released())
             {
                 // Fire!
                 throwerCtx->isCharging = false;
 
                 if (throwerCtx->currentCharge > 10.0f) // minimum power threshold
                 {
-                    // Spawn projectile at thrower position with physics properties
-                    PhysicsMaterial boxPhysics;
-                    boxPhysics.density = 0.1f; // Light projectile for snappier throws
-                    boxPhysics.friction = 0.4f;
-                    boxPhysics.restitution = 0.3f;
-                    boxPhysics.linearDamping = 0.1f;
-                    boxPhysics.angularDamping = 0.1f;
-                    boxPhysics.affectedByGravity = true;
-
-                    VisualStyle boxVisual;
-                    boxVisual.color = ORANGE;
-                    boxVisual.roundness = 0.2f;
-                    boxVisual.useTexture = true;
-
-                    GameEntity proj = makeBoxEntity(ctx.entityManager, ctx.worldId, ctx.boxTexture,
-                                                    ctx.boxPolygon, ctx.boxExtent, throwerPos,
-                                                    true, boxPhysics, boxVisual);
-
-                    // Apply impulse in aim direction
-                    // Scale impulse to physics units (divide by lengthUnitsPerMeter to convert power from pixel-based to meter-based)
-                    float impulseScale = (throwerCtx->currentCharge / ctx.lengthUnitsPerMeter) * throwerCtx->impulseMultiplier;
-                    b2Vec2 impulse = {throwerCtx->aimDir.x * impulseScale, throwerCtx->aimDir.y * impulseScale};
-                    b2Body_ApplyLinearImpulse(proj.body.id, impulse, throwerPos, true);
-
-                    ctx.boxes.push_back(proj);
-
+                    FireThrower(ctx, throwerId, *throwerCtx);
                     throwerCtx->currentCharge = 0.0f; // Reset after firing
                 }
             }
         }
     }
+}
+
+// Reads: Script, SpikeProperties. Writes: SawRotation, ThrowerContext (what the script hooks touch)
+inline void UpdateScripts(LogicContext &ctx, float deltaTime)
+{
+    if (ctx.isPaused)
+        return;
+
+    ComponentStore &store = ctx.store;
 
-    // Per-entity logic update
-    auto updateEntities = [deltaTime](std::vector<GameEntity> &entities)
+    // Per-entity logic update: scripts are packed, so this is one linear pass.
+    // Passive entities (boxes, obstacles) have no update hook and cost one check.
+    // Hooks only touch their own entity's components, so chunks can run in parallel.
+    const auto &scripts = store.pool<Script>();
+    auto updateRange = [&](uint32_t begin, uint32_t end, uint32_t /*slot*/)
     {
-        for (auto &e : entities)
+        for (uint32_t i = begin; i < end; ++i)
         {
-            if (e.script.update)
-                e.script.update(e, deltaTime);
+            Script::UpdateFn update = scripts.at(i).update;
+            if (update)
+                update(store, scripts.entity(i), deltaTime);
         }
     };
+    const uint32_t scriptCount = static_cast<uint32_t>(scripts.size());
+    if (ctx.jobs)
+        ctx.jobs->parallelFor(scriptCount, 64, updateRange);
+    else
+        updateRange(0, scriptCount, 0);
+}
 
-    updateEntities(ctx.boxes);
-    updateEntities(ctx.obstacles);
-    updateEntities(ctx.spikes);
-    updateEntities(ctx.throwers);
+// Main logic update, all stages in order on the calling thread:
+// physics, collision, input, entity updates
+inline void UpdateLogic(LogicContext &ctx, const TickInput &input, float deltaTime)
+{
+    StepPhysics(ctx, deltaTime);
+    UpdateCapture(ctx);
+    UpdateThrower(ctx, input);
+    UpdateScripts(ctx, deltaTime);
 }
@@ -7,7 +7,12 @@
 #include "../components/transform.hpp"
 #include "../components/visual_style.hpp"
 #include "../entities/types.hpp"
+#include "../core/spatial_grid.hpp"
+#include "camera_system.hpp"
+#include "sprite_batch.hpp"
+#include "static_tiles.hpp"
 
+#include <algorithm>
 #include <vector>
 #include <cmath>
 #include <cstdio>
@@ -22,69 +27,177 @@ struct DebugRope
     float ropeLenM{12.0f};
 };
 
+// Radius around an entity's pose holding everything its render hook draws (pixels)
+inline float RenderRadius(const ComponentStore &store, EntityId id)
+{
+    const SpriteTransform *transform = store.tryGet<SpriteTransform>(id);
+    const b2Vec2 extent = transform ? transform->extent : b2Vec2{0.0f, 0.0f};
+    float radius = sqrtf(extent.x * extent.x + extent.y * extent.y);
+
+    if (store.has<BoxTag>(id))
+    {
+        // DrawSprite: the image at its own size from the bottom-left corner
+        if (const Sprite *sprite = store.tryGet<Sprite>(id))
+        {
+            const float x = std::max(extent.x, sprite->width() - extent.x);
+            const float y = std::max(extent.y, sprite->height() - extent.y);
+            radius = std::max(radius, sqrtf(x * x + y * y));
+        }
+    }
+    else if (const SpikeProperties *spike = store.tryGet<SpikeProperties>(id))
+    {
+        radius *= 1.3f; // saw teeth
+        if (spike->type == SpikeType::CHAIN)
+        {
+            // Rope, links and hook hang from the spike
+            float hook = 0.0f;
+            if (const ChainContext *chain = store.tryGet<ChainContext>(id))
+                hook = sqrtf(chain->halfW * spike->hookScaleW * chain->halfW * spike->hookScaleW +
+                             chain->halfH * spike->hookScaleH * chain->halfH * spike->hookScaleH);
+            radius += spike->chainLength + hook;
+        }
+    }
+    else if (store.has<ThrowerTag>(id))
+        radius = std::max(radius, 203.0f); // aim line while charging
+    return radius;
+}
+
+// Which entities a frame draws. The spatial grid (entity poses as points)
+// finds the ones near the view; the few whose drawing reaches further than
+// gridRadius from their pose (long chains, wide platforms) are kept in a list
+// and tested on their own. Every candidate is then checked with its render
+// radius against the view. The list is rebuilt only when entities are added or
+// removed (PoseCache structure version).
+struct RenderCulling
+{
+    SpatialGrid *grid{nullptr}; // optional: without it every entity is tested
+    float gridRadius{192.0f};   // render radius up to which the grid query finds an entity
+    float slack{64.0f};         // grid poses are the last tick's, drawn poses are blended
+    std::vector<EntityId> large;
+    uint32_t version{0xFFFFFFFFu};
+    std::vector<EntityId> candidates; // scratch
+    std::vector<EntityId> visible;    // last frame's result
+    std::size_t drawn{0};             // last frame: entities submitted
+    std::size_t total{0};             // last frame: entities with a render hook
+
+    // Entities with a render hook whose drawing may overlap `view`, by entity index
+    const std::vector<EntityId> &collect(const ComponentStore &store, Rectangle view)
+    {
+        const PoseCache &poses = store.pool<BodyPose>();
+        const ComponentPool<Script> &scripts = store.pool<Script>();
+        if (version != poses.structureVersion())
+        {
+            large.clear();
+            for (EntityId id : scripts.entities())
+            {
+                if (RenderRadius(store, id) > gridRadius)
+                    large.push_back(id);
+            }
+            version = poses.structureVersion();
+        }
+
+        candidates.clear();
+        if (grid)
+        {
+            // The renderer may run before any tick synced the grid (paused, restored)
+            grid->update(poses);
+            const float pad = gridRadius + slack;
+            candidates.resize(std::max<std::size_t>(candidates.capacity(), 256));
+            std::size_t found = grid->queryAabb(view.x - pad, view.y - pad, view.x + view.width + pad,
+                                                view.y + view.height + pad, candidates.data(), candidates.size());
+            if (found > candidates.size())
+            {
+                candidates.resize(found);
+                found = grid->queryAabb(view.x - pad, view.y - pad, view.x + view.width + pad,
+                                        view.y + view.height + pad, candidates.data(), candidates.size());
+            }
+            candidates.resize(found);
+            candidates.insert(candidates.end(), large.begin(), large.end());
+        }
+        else
+            candidates = scripts.entities();
+
+        // Entity order keeps the draw order inside a layer stable from frame to frame
+        std::sort(candidates.begin(), candidates.end(), [](EntityId a, EntityId b)
+                  { return a.index < b.index; });
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+        visible.clear();
+        for (EntityId id : candidates)
+        {
+            if (!scripts.has(id) || !poses.has(id))
+                continue;
+            const BodyPose pose = poses.interpolated(id);
+            const float r = RenderRadius(store, id);
+            if (CheckCollisionRecs({pose.x - r, pose.y - r, 2.0f * r, 2.0f * r}, view))
+                visible.push_back(id);
+        }
+        drawn = visible.size();
+        total = scripts.size();
+        return visible;
+    }
+};
+
 // Context for rendering
 struct RenderContext
 {
     int screenWidth;
     int screenHeight;
     float lengthUnitsPerMeter;
-    std::vector<GameEntity> &boxes;
-    std::vector<GameEntity> &obstacles;
-    std::vector<GameEntity> &spikes;
-    std::vector<GameEntity> &throwers;
+    ComponentStore &store;
     bool showDebugWireframe;
-    DebugRope *debugRope; // optional
+    DebugRope *debugRope;                  // optional
+    SpriteBatch &batch;                    // world quads of the frame; cleared by the caller before submitting
+    const GameCamera *camera{nullptr};     // optional: world drawn through it (else world = screen pixels)
+    RenderCulling *culling{nullptr};       // optional: only entities overlapping the view are submitted
+    StaticTileCache *staticTiles{nullptr}; // optional: obstacles drawn from baked tiles
 };
 
-// Draw a sprite using physics body transform and extent conversion
-inline void DrawSprite(const PhysicsBody &body,
+// Pose to draw for an entity: the cached body pose blended between the last two
+// fixed steps (PoseCache::interpolated), so motion stays smooth at any frame rate
+inline BodyPose DrawPose(const ComponentStore &store, EntityId id)
+{
+    return store.pool<BodyPose>().interpolated(id);
+}
+
+// Submit a sprite using the cached body pose (pixels) and extent: the image
+// at its own size from the body's bottom-left corner, or a solid rectangle
+// (rounded by visual.roundness when the batch has the SDF shader)
+inline void DrawSprite(SpriteBatch &batch,
+                       const BodyPose &pose,
                        const Sprite &sprite,
                        const SpriteTransform &transform,
-                       const VisualStyle &visual,
-                       float lengthUnitsPerMeter)
+                       const VisualStyle &visual)
 {
-    b2Vec2 pos = b2Body_GetPosition(body.id);
-    b2Rot rotation = b2Body_GetRotation(body.id);
-    float radians = b2Rot_GetAngle(rotation);
-    Vector2 center = {pos.x * lengthUnitsPerMeter, pos.y * lengthUnitsPerMeter};
-
     if (visual.useTexture && sprite.texture.id > 0)
     {
-        // Convert extent from pixels to meters
-        b2Vec2 extentMeters = {transform.extent.x / lengthUnitsPerMeter,
-                               transform.extent.y / lengthUnitsPerMeter};
-
-        // Bottom-left world point given body pose
-        b2Vec2 p = b2Body_GetWorldPoint(body.id, (b2Vec2){-extentMeters.x, -extentMeters.y});
-
-        // Convert to pixels and draw
-        Vector2 ps = {p.x * lengthUnitsPerMeter, p.y * lengthUnitsPerMeter};
-        DrawTextureEx(sprite.texture, ps, RAD2DEG * radians, 1.0f, visual.color);
+        const Vector2 half = {0.5f * sprite.width(), 0.5f * sprite.height()};
+        const b2Vec2 center = pose.transformPoint({half.x - transform.extent.x, half.y - transform.extent.y});
+        batch.box(sprite.texture, sprite.source, {center.x, center.y}, half, pose.c, pose.s, visual.color);
     }
+    else if (visual.roundness > 0.0f && batch.hasSdf())
+        batch.roundedBox({pose.x, pose.y}, {transform.extent.x, transform.extent.y}, visual.roundness, pose.c, pose.s,
+                         visual.color);
     else
-    {
-        // Draw solid color rectangle with optional roundness
-        Vector2 size = {2.0f * transform.extent.x, 2.0f * transform.extent.y};
-        Rectangle rect = {center.x, center.y, size.x, size.y};
-        Vector2 origin = {transform.extent.x, transform.extent.y};
-
-        if (visual.roundness > 0.0f)
-        {
-            // For rounded rectangles, we need to draw without rotation first
-            // then apply manual rotation (raylib doesn't support rotated rounded rects directly)
-            // For now, approximate with regular DrawRectanglePro and visual.roundness as a hint
-            DrawRectanglePro(rect, origin, RAD2DEG * radians, visual.color);
-        }
-        else
-        {
-            DrawRectanglePro(rect, origin, RAD2DEG * radians, visual.color);
-        }
-    }
+        batch.rect({pose.x, pose.y}, {transform.extent.x, transform.extent.y}, pose.c, pose.s, visual.color);
 }
 
-// Main render function: handles all drawing for a frame
+// Main render function: opens the frame, submits every entity to ctx.batch on
+// top of what the caller already put there (world-space ads), draws the batch
+// and the debug overlay through the camera. The frame stays open for
+// screen-space overlays; the caller ends it with EndDrawing().
 inline void RenderFrame(const RenderContext &ctx)
 {
+    const ComponentStore &store = ctx.store;
+
+    // Everything drawn through the camera is in world pixels
+    const Rectangle view = ctx.camera ? ctx.camera->ViewBounds()
+                                      : Rectangle{0.0f, 0.0f, (float)ctx.screenWidth, (float)ctx.screenHeight};
+
+    // Bake static tiles entering the view (render targets: before the frame opens)
+    if (ctx.staticTiles)
+        ctx.staticTiles->prepare(store, view, ctx.lengthUnitsPerMeter);
+
     BeginDrawing();
     ClearBackground(DARKGRAY);
 
@@ -94,37 +207,81 @@ inline void RenderFrame(const RenderContext &ctx)
     int textWidth = MeasureText(message, fontSize);
     DrawText(message, (ctx.screenWidth - textWidth) / 2, 50, fontSize, LIGHTGRAY);
 
-    // Per-entity render hooks
-    auto renderEntities = [&ctx](const std::vector<GameEntity> &entities)
+    if (ctx.camera)
+        BeginMode2D(ctx.camera->ToCamera2D());
+
+    // Per-entity render hooks into the layer of their category, then one
+    // sorted submission for all of them
+    SpriteBatch &batch = ctx.batch;
+    auto renderHook = [&ctx, &store, &batch](EntityId id, const Script &script)
     {
-        for (const auto &e : entities)
-        {
-            if (e.script.render)
-                e.script.render(e, ctx.lengthUnitsPerMeter);
-        }
+        if (script.render)
+            script.render(store, id, ctx.lengthUnitsPerMeter, batch);
     };
 
-    renderEntities(ctx.boxes);
-    renderEntities(ctx.obstacles);
-    renderEntities(ctx.spikes);
-    renderEntities(ctx.throwers);
+    const bool bakedObstacles = ctx.staticTiles != nullptr;
+    if (bakedObstacles)
+    {
+        batch.setLayer(RenderLayer::Obstacles);
+        ctx.staticTiles->submit(batch);
+    }
+
+    if (ctx.culling)
+    {
+        for (EntityId id : ctx.culling->collect(store, view))
+        {
+            if (store.has<BoxTag>(id))
+                batch.setLayer(RenderLayer::Boxes);
+            else if (store.has<ObstacleTag>(id))
+            {
+                if (bakedObstacles)
+                    continue;
+                batch.setLayer(RenderLayer::Obstacles);
+            }
+            else if (store.has<SpikeProperties>(id))
+                batch.setLayer(RenderLayer::Spikes);
+            else if (store.has<ThrowerTag>(id))
+                batch.setLayer(RenderLayer::Thrower);
+            else
+                continue;
+            renderHook(id, store.get<Script>(id));
+        }
+    }
+    else
+    {
+        batch.setLayer(RenderLayer::Boxes);
+        store.view<BoxTag, Script>().each([&](EntityId id, const BoxTag &, const Script &script)
+                                          { renderHook(id, script); });
+        if (!bakedObstacles)
+        {
+            batch.setLayer(RenderLayer::Obstacles);
+            store.view<ObstacleTag, Script>().each([&](EntityId id, const ObstacleTag &, const Script &script)
+                                                   { renderHook(id, script); });
+        }
+        batch.setLayer(RenderLayer::Spikes);
+        store.view<SpikeProperties, Script>().each([&](EntityId id, const SpikeProperties &, const Script &script)
+                                                   { renderHook(id, script); });
+        batch.setLayer(RenderLayer::Thrower);
+        store.view<ThrowerTag, Script>().each([&](EntityId id, const ThrowerTag &, const Script &script)
+                                              { renderHook(id, script); });
+    }
+    batch.draw();
 
     // Debug wireframe overlay
     if (ctx.showDebugWireframe)
     {
         // Draw boxes
-        for (const auto &box : ctx.boxes)
+        auto drawBox = [&store](EntityId id, const BoxTag &, const SpriteTransform &transform, const Impaled &impaled)
         {
-            b2Vec2 pos = b2Body_GetPosition(box.body.id);
-            b2Rot rot = b2Body_GetRotation(box.body.id);
-            float angle = b2Rot_GetAngle(rot);
-            Vector2 center = {pos.x * ctx.lengthUnitsPerMeter, pos.y * ctx.lengthUnitsPerMeter};
-            Vector2 size = {2.0f * box.transform.extent.x, 2.0f * box.transform.extent.y};
+            const BodyPose pose = DrawPose(store, id);
+            float angle = pose.angle();
+            Vector2 center = {pose.x, pose.y};
+            Vector2 size = {2.0f * transform.extent.x, 2.0f * transform.extent.y};
 
-            Color wireColor = box.impaled.frozen ? GREEN : LIME;
+            Color wireColor = impaled.frozen ? GREEN : LIME;
             DrawRectanglePro(
                 (Rectangle){center.x, center.y, size.x, size.y},
-                (Vector2){box.transform.extent.x, box.transform.extent.y},
+                (Vector2){transform.extent.x, transform.extent.y},
                 RAD2DEG * angle,
                 Fade(wireColor, 0.0f));
             // Draw outline
@@ -132,63 +289,71 @@ inline void RenderFrame(const RenderContext &ctx)
 
             // Draw center point
             DrawCircleV(center, 3.0f, wireColor);
-        }
+        };
+        store.view<BoxTag, SpriteTransform, Impaled>().each(drawBox);
 
         // Draw obstacles
-        for (const auto &obs : ctx.obstacles)
+        auto drawObstacle = [&store](EntityId id, const ObstacleTag &, const SpriteTransform &transform)
         {
-            b2Vec2 pos = b2Body_GetPosition(obs.body.id);
-            Vector2 center = {pos.x * ctx.lengthUnitsPerMeter, pos.y * ctx.lengthUnitsPerMeter};
-            Vector2 size = {2.0f * obs.transform.extent.x, 2.0f * obs.transform.extent.y};
+            const BodyPose pose = DrawPose(store, id);
+            Vector2 center = {pose.x, pose.y};
+            Vector2 size = {2.0f * transform.extent.x, 2.0f * transform.extent.y};
             DrawRectangleLines(center.x - size.x / 2, center.y - size.y / 2, size.x, size.y, BLUE);
             DrawCircleV(center, 3.0f, BLUE);
-        }
+        };
+        store.view<ObstacleTag, SpriteTransform>().each(drawObstacle);
 
         // Draw spikes (and chain debug if present)
-        for (const auto &spike : ctx.spikes)
+        const auto &spikePool = store.pool<SpikeProperties>();
+        for (std::size_t i = 0; i < spikePool.size(); ++i)
         {
-            b2Vec2 pos = b2Body_GetPosition(spike.body.id);
-            Vector2 center = {pos.x * ctx.lengthUnitsPerMeter, pos.y * ctx.lengthUnitsPerMeter};
-            float r = (spike.transform.extent.x + spike.transform.extent.y) * 0.5f;
+            EntityId id = spikePool.entity(i);
+            const SpikeProperties &spikeProps = spikePool.at(i);
+            const SpriteTransform &transform = store.get<SpriteTransform>(id);
+            const BodyPose pose = DrawPose(store, id);
+            Vector2 center = {pose.x, pose.y};
+            float r = (transform.extent.x + transform.extent.y) * 0.5f;
             DrawCircleLines(center.x, center.y, r, RED);
             DrawCircleV(center, 4.0f, RED);
 
             // Chain/Rope system debug overlay (bright outlines)
-            if (spike.spikeProps.type == SpikeType::CHAIN && spike.script.user)
+            if (spikeProps.type == SpikeType::CHAIN)
             {
-                struct ChainContext
-                {
-                    b2BodyId hookBody;
-                    float halfW;
-                    float halfH;
-                };
-                auto *spikeCtx = static_cast<ChainContext *>(spike.script.user);
+                const ChainContext *spikeCtx = store.tryGet<ChainContext>(id);
                 if (spikeCtx)
                 {
                     Color ropeColor = SKYBLUE;
                     Color hookColor = YELLOW;
                     // Draw rope line from spike bottom to hook top
-                    b2Vec2 sp = b2Body_GetPosition(spike.body.id);
-                    Vector2 sc = {sp.x * ctx.lengthUnitsPerMeter, sp.y * ctx.lengthUnitsPerMeter};
-                    Vector2 anchorBot = {sc.x, sc.y + spike.transform.extent.y};
-                    b2Vec2 hp = b2Body_GetPosition(spikeCtx->hookBody);
-                    b2Rot hr = b2Body_GetRotation(spikeCtx->hookBody);
-                    float ha = b2Rot_GetAngle(hr);
-                    Vector2 hc = {hp.x * ctx.lengthUnitsPerMeter, hp.y * ctx.lengthUnitsPerMeter};
-                    Vector2 topOff = {0.0f, -spikeCtx->halfH * spike.spikeProps.hookScaleH};
-                    float ca = cosf(ha), sa = sinf(ha);
+                    Vector2 anchorBot = {center.x, center.y + transform.extent.y};
+                    const BodyPose hookPose = DrawPose(store, spikeCtx->hook);
+                    Vector2 hc = {hookPose.x, hookPose.y};
+                    Vector2 topOff = {0.0f, -spikeCtx->halfH * spikeProps.hookScaleH};
+                    float ca = hookPose.c, sa = hookPose.s;
                     Vector2 hookTop = {hc.x + topOff.x * ca - topOff.y * sa, hc.y + topOff.x * sa + topOff.y * ca};
-                    DrawLineEx(anchorBot, hookTop, 2.0f, ropeColor);
+                    if (spikeCtx->expanded())
+                    {
+                        // Link centers, spike to hook
+                        Vector2 prev = anchorBot;
+                        for (EntityId link : spikeCtx->links)
+                        {
+                            const BodyPose linkPose = DrawPose(store, link);
+                            DrawLineEx(prev, {linkPose.x, linkPose.y}, 2.0f, ropeColor);
+                            DrawCircleV({linkPose.x, linkPose.y}, 2.0f, ropeColor);
+                            prev = {linkPose.x, linkPose.y};
+                        }
+                        DrawLineEx(prev, hookTop, 2.0f, ropeColor);
+                    }
+                    else
+                        DrawLineEx(anchorBot, hookTop, 2.0f, ropeColor);
 
                     // Draw hook outline (scaled)
                     {
-                        Vector2 hsize = {2.0f * spikeCtx->halfW * spike.spikeProps.hookScaleW,
-                                         2.0f * spikeCtx->halfH * spike.spikeProps.hookScaleH};
+                        Vector2 hsize = {2.0f * spikeCtx->halfW * spikeProps.hookScaleW,
+                                         2.0f * spikeCtx->halfH * spikeProps.hookScaleH};
                         Vector2 half = {hsize.x * 0.5f, hsize.y * 0.5f};
                         Vector2 corners[4] = {
                             {-half.x, -half.y}, {half.x, -half.y}, {half.x, half.y}, {-half.x, half.y}};
-                        ca = cosf(ha);
-                        sa = sinf(ha);
                         for (int i = 0; i < 4; ++i)
                         {
                             float rx = corners[i].x * ca - corners[i].y * sa;
@@ -208,11 +373,12 @@ inline void RenderFrame(const RenderContext &ctx)
         }
 
         // Draw thrower
-        for (const auto &thrower : ctx.throwers)
+        for (EntityId id : store.pool<ThrowerTag>().entities())
         {
-            b2Vec2 pos = b2Body_GetPosition(thrower.body.id);
-            Vector2 center = {pos.x * ctx.lengthUnitsPerMeter, pos.y * ctx.lengthUnitsPerMeter};
-            Vector2 size = {2.0f * thrower.transform.extent.x, 2.0f * thrower.transform.extent.y};
+            const SpriteTransform &transform = store.get<SpriteTransform>(id);
+            const BodyPose pose = DrawPose(store, id);
+            Vector2 center = {pose.x, pose.y};
+            Vector2 size = {2.0f * transform.extent.x, 2.0f * transform.extent.y};
             DrawRectangleLines(center.x - size.x / 2, center.y - size.y / 2, size.x, size.y, YELLOW);
             DrawCircleV(center, 4.0f, YELLOW);
         }
@@ -228,14 +394,32 @@ inline void RenderFrame(const RenderContext &ctx)
             DrawCircleV(a, 5.0f, RAYWHITE);
             DrawCircleV(w, 6.0f, YELLOW);
         }
+    }
+    if (ctx.camera)
+        EndMode2D();
 
-        DrawText("DEBUG MODE (D to toggle) — Chain/Rope overlay active | R: toggle debug rope",
+    if (ctx.showDebugWireframe)
+    {
+        DrawText("DEBUG MODE (D to toggle) — Chain/Rope overlay active",
                  10, ctx.screenHeight - 30, 20, WHITE);
-        char entityCount[100];
-        snprintf(entityCount, sizeof(entityCount), "Boxes: %zu | Obstacles: %zu | Spikes: %zu",
-                 ctx.boxes.size(), ctx.obstacles.size(), ctx.spikes.size());
+        char entityCount[192];
+        snprintf(entityCount, sizeof(entityCount), "Boxes: %zu | Obstacles: %zu | Spikes: %zu | Quads: %zu in %zu batches",
+                 store.pool<BoxTag>().size(), store.pool<ObstacleTag>().size(), store.pool<SpikeProperties>().size(),
+                 batch.size(), batch.lastRuns());
         DrawText(entityCount, 10, ctx.screenHeight - 60, 20, WHITE);
+        if (ctx.culling)
+        {
+            char culled[96];
+            snprintf(culled, sizeof(culled), "Drawn: %zu of %zu entities", ctx.culling->drawn, ctx.culling->total);
+            DrawText(culled, 10, ctx.screenHeight - 90, 20, WHITE);
+        }
+        if (ctx.staticTiles)
+        {
+            char tiles[128];
+            snprintf(tiles, sizeof(tiles), "Static tiles: %zu drawn, %zu cached (%.1f MB), %zu baked this frame",
+                     ctx.staticTiles->visibleCount(), ctx.staticTiles->tileCount(),
+                     ctx.staticTiles->usedBytes() / (1024.0 * 1024.0), ctx.staticTiles->bakedLastFrame());
+            DrawText(tiles, 10, ctx.screenHeight - 120, 20, WHITE);
+        }
     }
-
-    EndDrawing();
 }
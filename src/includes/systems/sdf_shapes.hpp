@@ -0,0 +1,116 @@
+#pragma once
+#include "raylib.h"
+
+// Distance-field shader for SpriteBatch::saw / roundedBox / disc.
+//
+// Each shape is one quad of the sprite batch, so a layer's saws, hooks and
+// discs go to the GPU as one run. Per-instance data rides on the batch's own
+// vertex attributes (rlgl has no instancing for 2D):
+// - position: the quad, already rotated (the saw's spin is free)
+// - texcoord: pixels from the shape centre in the shape's frame
+// - normal:   x = shape (SdfShape) + fraction, y and z = shape parameters
+//               Saw:    radius, teeth
+//               Box:    half width, half height; fraction = roundness / 2
+//               Circle: radius
+// - color:    tint
+// The fragment shader turns the signed distance into coverage with fwidth,
+// so edges stay one pixel wide at any camera zoom.
+
+// Saw colours match the shape drawing SpikeRender falls back to:
+// teeth DARKGRAY, hub GRAY, blade tint
+#define IMPALE_SDF_BODY                                                                            \
+    "const float PI2 = 6.2831853;\n"                                                               \
+    "float coverage(float d) { float w = max(fwidth(d), 0.0001); return clamp(0.5 - d / w, 0.0, 1.0); }\n" \
+    "vec4 shade(vec2 q, vec3 p, vec4 tint)\n"                                                      \
+    "{\n"                                                                                          \
+    "    float shape = floor(p.x + 0.001);\n"                                                      \
+    "    if (shape < 0.5)\n"                                                                       \
+    "    {\n"                                                                                      \
+    "        float r = p.y;\n"                                                                     \
+    "        float dist = length(q);\n"                                                            \
+    "        float period = PI2 / max(p.z, 1.0);\n"                                                \
+    "        float width = 0.764 * period;\n"                                                      \
+    "        float phase = mod(atan(q.y, q.x), period);\n"                                         \
+    "        float t = max(1.0 - abs(phase - 0.5 * width) / (0.5 * width), 0.0);\n"                \
+    "        float blade = dist - r;\n"                                                            \
+    "        float outer = min(blade, dist - r * (1.0 + 0.3 * t));\n"                              \
+    "        vec3 rgb = mix(tint.rgb, vec3(80.0, 80.0, 80.0) / 255.0, coverage(-blade));\n"        \
+    "        rgb = mix(rgb, vec3(130.0, 130.0, 130.0) / 255.0, coverage(dist - 0.3 * r));\n"       \
+    "        return vec4(rgb, tint.a * coverage(outer));\n"                                        \
+    "    }\n"                                                                                      \
+    "    if (shape < 1.5)\n"                                                                       \
+    "    {\n"                                                                                      \
+    "        vec2 h = p.yz;\n"                                                                     \
+    "        float rad = 2.0 * (p.x - shape) * min(h.x, h.y);\n"                                   \
+    "        vec2 e = abs(q) - h + rad;\n"                                                         \
+    "        float d = length(max(e, 0.0)) + min(max(e.x, e.y), 0.0) - rad;\n"                    \
+    "        return vec4(tint.rgb, tint.a * coverage(d));\n"                                       \
+    "    }\n"                                                                                      \
+    "    return vec4(tint.rgb, tint.a * coverage(length(q) - p.y));\n"                             \
+    "}\n"
+
+#if defined(__EMSCRIPTEN__)
+static const char *const kSdfShapeVs =
+    "#version 100\n"
+    "attribute vec3 vertexPosition;\n"
+    "attribute vec2 vertexTexCoord;\n"
+    "attribute vec3 vertexNormal;\n"
+    "attribute vec4 vertexColor;\n"
+    "uniform mat4 mvp;\n"
+    "varying vec2 fragTexCoord;\n"
+    "varying vec3 fragParams;\n"
+    "varying vec4 fragColor;\n"
+    "void main()\n"
+    "{\n"
+    "    fragTexCoord = vertexTexCoord;\n"
+    "    fragParams = vertexNormal;\n"
+    "    fragColor = vertexColor;\n"
+    "    gl_Position = mvp * vec4(vertexPosition, 1.0);\n"
+    "}\n";
+
+static const char *const kSdfShapeFs =
+    "#version 100\n"
+    "#extension GL_OES_standard_derivatives : enable\n"
+    "precision mediump float;\n"
+    "varying vec2 fragTexCoord;\n"
+    "varying vec3 fragParams;\n"
+    "varying vec4 fragColor;\n"
+    IMPALE_SDF_BODY
+    "void main() { gl_FragColor = shade(fragTexCoord, fragParams, fragColor); }\n";
+#else
+static const char *const kSdfShapeVs =
+    "#version 330\n"
+    "in vec3 vertexPosition;\n"
+    "in vec2 vertexTexCoord;\n"
+    "in vec3 vertexNormal;\n"
+    "in vec4 vertexColor;\n"
+    "uniform mat4 mvp;\n"
+    "out vec2 fragTexCoord;\n"
+    "out vec3 fragParams;\n"
+    "out vec4 fragColor;\n"
+    "void main()\n"
+    "{\n"
+    "    fragTexCoord = vertexTexCoord;\n"
+    "    fragParams = vertexNormal;\n"
+    "    fragColor = vertexColor;\n"
+    "    gl_Position = mvp * vec4(vertexPosition, 1.0);\n"
+    "}\n";
+
+static const char *const kSdfShapeFs =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec3 fragParams;\n"
+    "in vec4 fragColor;\n"
+    "out vec4 finalColor;\n"
+    IMPALE_SDF_BODY
+    "void main() { finalColor = shade(fragTexCoord, fragParams, fragColor); }\n";
+#endif
+
+#undef IMPALE_SDF_BODY
+
+// Compile the shader (needs a GL context). On failure raylib hands back its
+// default shader, which SpriteBatch::setSdfShader treats as "no SDF".
+inline Shader LoadSdfShapeShader()
+{
+    return LoadShaderFromMemory(kSdfShapeVs, kSdfShapeFs);
+}
@@ -0,0 +1,301 @@
+#pragma once
+#include "raylib.h"
+#include "rlgl.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Draw order of the world, back to front. Within a layer quads are grouped by
+// texture, so things that overlap and must keep their order go in different layers.
+enum class RenderLayer : uint8_t
+{
+    Boxes,
+    Obstacles,
+    Spikes,
+    Thrower,
+    Ads // parallax and world-space ads, over the level
+};
+
+// Shapes drawn by the distance-field shader (sdf_shapes.hpp)
+enum class SdfShape : uint8_t
+{
+    Saw,    // disc with teeth and a hub
+    Box,    // rectangle with rounded corners
+    Circle
+};
+
+// Per-frame quad buffer for everything drawn in world space.
+// Render hooks submit textured or solid quads (solid ones use raylib's shapes
+// texture, so shapes and sprites batch together); draw() sorts them by
+// (layer, blend, shader, texture), keeping submission order inside a group, and hands
+// each group to rlgl as one RL_QUADS run. A frame then costs one draw call per
+// texture per layer instead of one per entity. Main thread only.
+//
+// Distance-field shapes (saw(), roundedBox(), disc()) are one quad each whose
+// shape is computed per pixel by the SDF shader, with the shape parameters
+// carried by the quad's vertices. All of them in a layer are one run, however
+// many there are. They need setSdfShader(); without it hasSdf() is false and
+// callers draw the shape from plain quads.
+//
+// Quads submitted while setPremultiplied(true) is on hold colours already
+// multiplied by alpha (baked render textures) and draw as their own runs with
+// BLEND_ALPHA_PREMULTIPLY; everything else uses raylib's default alpha blend.
+class SpriteBatch
+{
+public:
+    // Start a frame: drop last frame's quads (capacity is kept)
+    void clear()
+    {
+        quads.clear();
+        keys.clear();
+        layer = RenderLayer::Boxes;
+        premultiplied = false;
+    }
+
+    // Layer for the quads submitted from now on
+    void setLayer(RenderLayer value) { layer = value; }
+
+    // Whether the textures submitted from now on are premultiplied by alpha
+    void setPremultiplied(bool value) { premultiplied = value; }
+
+    // Shader for the distance-field shapes (LoadSdfShapeShader); raylib's
+    // default shader (a failed load) leaves them disabled
+    void setSdfShader(Shader shader) { sdfShader = shader; }
+    bool hasSdf() const { return sdfShader.id > 0 && sdfShader.id != rlGetShaderIdDefault(); }
+
+    // Raw quad: corners and texture coordinates in rlgl quad order
+    // (top-left, bottom-left, bottom-right, top-right for an upright sprite)
+    void quad(unsigned int texture, const std::array<Vector2, 4> &corners, const std::array<Vector2, 4> &uvs,
+              Color tint)
+    {
+        quads.push_back({corners, uvs, {0.0f, 0.0f, 1.0f}, tint, texture});
+        keys.push_back(key() | texture);
+    }
+
+    // Box of half size `half` centred on `center`, rotated by (cos, sin) as in
+    // BodyPose, showing `source` of `texture` (pixels; negative width/height flip)
+    void box(const Texture &texture, Rectangle source, Vector2 center, Vector2 half, float c, float s, Color tint)
+    {
+        const Vector2 ax = {c * half.x, s * half.x};  // rotated half x axis
+        const Vector2 ay = {-s * half.y, c * half.y}; // rotated half y axis
+        quad(texture.id,
+             {Vector2{center.x - ax.x - ay.x, center.y - ax.y - ay.y},
+              Vector2{center.x - ax.x + ay.x, center.y - ax.y + ay.y},
+              Vector2{center.x + ax.x + ay.x, center.y + ax.y + ay.y},
+              Vector2{center.x + ax.x - ay.x, center.y + ax.y - ay.y}},
+             uvRect(texture, source), tint);
+    }
+
+    // Same as DrawTexturePro: `dest` rotated by `degrees` around dest.xy + origin
+    void sprite(const Texture &texture, Rectangle source, Rectangle dest, Vector2 origin, float degrees, Color tint)
+    {
+        const float radians = DEG2RAD * degrees;
+        const float c = degrees == 0.0f ? 1.0f : cosf(radians);
+        const float s = degrees == 0.0f ? 0.0f : sinf(radians);
+        const Vector2 half = {0.5f * dest.width, 0.5f * dest.height};
+        const float lx = half.x - origin.x; // box centre relative to the pivot
+        const float ly = half.y - origin.y;
+        box(texture, source, {dest.x + c * lx - s * ly, dest.y + s * lx + c * ly}, half, c, s, tint);
+    }
+
+    // Solid rectangle, as box() without a texture
+    void rect(Vector2 center, Vector2 half, float c, float s, Color color)
+    {
+        box(GetShapesTexture(), GetShapesTextureRectangle(), center, half, c, s, color);
+    }
+
+    // Solid triangle (a degenerate quad, the way raylib draws it in quad mode)
+    void triangle(Vector2 a, Vector2 b, Vector2 c, Color color)
+    {
+        quad(GetShapesTexture().id, {a, b, b, c}, shapesUv(), color);
+    }
+
+    // Solid line of the given thickness
+    void line(Vector2 a, Vector2 b, float thick, Color color)
+    {
+        const float dx = b.x - a.x;
+        const float dy = b.y - a.y;
+        const float length = sqrtf(dx * dx + dy * dy);
+        if (length <= 0.0f)
+            return;
+        const float k = 0.5f * thick / length;
+        const Vector2 n = {-dy * k, dx * k};
+        quad(GetShapesTexture().id,
+             {Vector2{a.x - n.x, a.y - n.y}, Vector2{a.x + n.x, a.y + n.y},
+              Vector2{b.x + n.x, b.y + n.y}, Vector2{b.x - n.x, b.y - n.y}},
+             shapesUv(), color);
+    }
+
+    // Solid circle: a fan of kCircleSegments segments, two per quad
+    void circle(Vector2 center, float radius, Color color)
+    {
+        const std::array<Vector2, 4> uv = shapesUv();
+        const unsigned int texture = GetShapesTexture().id;
+        const std::array<Vector2, kCircleSegments + 1> &unit = UnitCircle();
+        for (int i = 0; i < kCircleSegments; i += 2)
+        {
+            quad(texture,
+                 {center,
+                  Vector2{center.x + unit[i + 2].x * radius, center.y + unit[i + 2].y * radius},
+                  Vector2{center.x + unit[i + 1].x * radius, center.y + unit[i + 1].y * radius},
+                  Vector2{center.x + unit[i].x * radius, center.y + unit[i].y * radius}},
+                 uv, color);
+        }
+    }
+
+    // Saw blade of `radius` with `teeth` teeth (reaching 1.3 * radius) turned
+    // by (cos, sin), as SpikeRender draws it from circles and triangles
+    void saw(Vector2 center, float radius, int teeth, float c, float s, Color color)
+    {
+        const float reach = 1.3f * radius + 1.0f; // teeth plus a pixel for the edge
+        sdf(SdfShape::Saw, 0.0f, radius, static_cast<float>(teeth), center, {reach, reach}, c, s, color);
+    }
+
+    // Rectangle of half size `half` with corners rounded as DrawRectangleRounded
+    // (roundness 0..1 of the shorter side)
+    void roundedBox(Vector2 center, Vector2 half, float roundness, float c, float s, Color color)
+    {
+        const float r = std::min(std::max(roundness, 0.0f), 1.0f);
+        sdf(SdfShape::Box, 0.5f * r, half.x, half.y, center, {half.x + 1.0f, half.y + 1.0f}, c, s, color);
+    }
+
+    // Solid circle in one quad
+    void disc(Vector2 center, float radius, Color color)
+    {
+        sdf(SdfShape::Circle, 0.0f, radius, 0.0f, center, {radius + 1.0f, radius + 1.0f}, 1.0f, 0.0f, color);
+    }
+
+    // Sort and submit everything to rlgl; the batch keeps its quads until clear()
+    void draw()
+    {
+        order.resize(quads.size());
+        for (std::size_t i = 0; i < order.size(); ++i)
+            order[i] = static_cast<uint32_t>(i);
+        std::stable_sort(order.begin(), order.end(), [this](uint32_t a, uint32_t b)
+                         { return keys[a] < keys[b]; });
+
+        runs = 0;
+        std::size_t i = 0;
+        while (i < order.size())
+        {
+            const uint64_t key = keys[order[i]];
+            const bool shaded = (key & kSdfBit) != 0;
+            const bool blended = (key & kPremultipliedBit) != 0;
+            if (blended)
+                BeginBlendMode(BLEND_ALPHA_PREMULTIPLY);
+            if (shaded)
+                BeginShaderMode(sdfShader);
+            rlSetTexture(quads[order[i]].texture);
+            rlBegin(RL_QUADS);
+            for (; i < order.size() && keys[order[i]] == key; ++i)
+            {
+                const Quad &q = quads[order[i]];
+                rlCheckRenderBatchLimit(4); // a full rlgl buffer is flushed, the run goes on
+                rlColor4ub(q.tint.r, q.tint.g, q.tint.b, q.tint.a);
+                rlNormal3f(q.params.x, q.params.y, q.params.z);
+                for (int v = 0; v < 4; ++v)
+                {
+                    rlTexCoord2f(q.uv[v].x, q.uv[v].y);
+                    rlVertex2f(q.corners[v].x, q.corners[v].y);
+                }
+            }
+            rlEnd();
+            if (shaded)
+                EndShaderMode();
+            if (blended)
+                EndBlendMode();
+            ++runs;
+        }
+        rlSetTexture(0);
+    }
+
+    std::size_t size() const { return quads.size(); }
+    // Texture runs the last draw() submitted (an upper bound on its draw calls)
+    std::size_t lastRuns() const { return runs; }
+
+private:
+    static constexpr int kCircleSegments = 24;
+    static constexpr uint64_t kSdfBit = uint64_t{1} << 32;
+    static constexpr uint64_t kPremultipliedBit = uint64_t{1} << 33;
+
+    struct Quad
+    {
+        std::array<Vector2, 4> corners;
+        std::array<Vector2, 4> uv;
+        Vector3 params; // vertex normal: SDF shape parameters, (0, 0, 1) otherwise
+        Color tint;
+        unsigned int texture;
+    };
+
+    std::vector<Quad> quads;
+    std::vector<uint64_t> keys; // layer << 34 | premultiplied << 33 | SDF << 32 | texture id, parallel to quads
+    std::vector<uint32_t> order;
+    RenderLayer layer{RenderLayer::Boxes};
+    bool premultiplied{false};
+    Shader sdfShader{0, nullptr};
+    std::size_t runs{0};
+
+    // Distance-field quad of half size `half`, rotated by (cos, sin). Its
+    // texture coordinates are pixels from the centre in the shape's frame, and
+    // its normal carries (shape + fraction, a, b), see sdf_shapes.hpp
+    void sdf(SdfShape shape, float fraction, float a, float b, Vector2 center, Vector2 half, float c, float s,
+             Color color)
+    {
+        const Vector2 ax = {c * half.x, s * half.x};
+        const Vector2 ay = {-s * half.y, c * half.y};
+        quads.push_back({{Vector2{center.x - ax.x - ay.x, center.y - ax.y - ay.y},
+                          Vector2{center.x - ax.x + ay.x, center.y - ax.y + ay.y},
+                          Vector2{center.x + ax.x + ay.x, center.y + ax.y + ay.y},
+                          Vector2{center.x + ax.x - ay.x, center.y + ax.y - ay.y}},
+                         {Vector2{-half.x, -half.y}, Vector2{-half.x, half.y}, Vector2{half.x, half.y},
+                          Vector2{half.x, -half.y}},
+                         {static_cast<float>(shape) + fraction, a, b},
+                         color,
+                         GetShapesTexture().id});
+        keys.push_back(key() | kSdfBit | GetShapesTexture().id);
+    }
+
+    // Sort key bits of the current state, above the texture id
+    uint64_t key() const
+    {
+        return (static_cast<uint64_t>(layer) << 34) | (premultiplied ? kPremultipliedBit : 0);
+    }
+
+    static std::array<Vector2, 4> uvRect(const Texture &texture, Rectangle source)
+    {
+        if (texture.width <= 0 || texture.height <= 0)
+            return shapesUv();
+        const float w = static_cast<float>(texture.width);
+        const float h = static_cast<float>(texture.height);
+        const float u0 = source.x / w;
+        const float v0 = source.y / h;
+        const float u1 = (source.x + source.width) / w;
+        const float v1 = (source.y + source.height) / h;
+        return {Vector2{u0, v0}, Vector2{u0, v1}, Vector2{u1, v1}, Vector2{u1, v0}};
+    }
+
+    static std::array<Vector2, 4> shapesUv()
+    {
+        return uvRect(GetShapesTexture(), GetShapesTextureRectangle());
+    }
+
+    // Unit circle points, computed once instead of per circle per frame
+    static const std::array<Vector2, kCircleSegments + 1> &UnitCircle()
+    {
+        static const std::array<Vector2, kCircleSegments + 1> points = []
+        {
+            std::array<Vector2, kCircleSegments + 1> p{};
+            for (int i = 0; i <= kCircleSegments; ++i)
+            {
+                const float a = 2.0f * PI * i / kCircleSegments;
+                p[i] = {cosf(a), sinf(a)};
+            }
+            return p;
+        }();
+        return points;
+    }
+};
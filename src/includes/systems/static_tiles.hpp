@@ -0,0 +1,276 @@
+#pragma once
+#include "raylib.h"
+#include "rlgl.h"
+
+#include "../entities/types.hpp"
+#include "sprite_batch.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+// Static level geometry baked into world-aligned tiles.
+//
+// Obstacles are b2_staticBody and never move, so instead of running their
+// render hooks every frame the world is cut into tileSize x tileSize pixel
+// tiles and each tile that holds obstacles is drawn once into a
+// RenderTexture. A frame then submits one textured quad per visible tile.
+//
+// - Tiles are baked lazily by prepare() when they first overlap the view.
+// - Baked tiles live in an LRU. Once the cache is over budgetBytes (RGBA8,
+//   tileSize^2 * 4 bytes per tile), the least recently drawn tiles are freed.
+//   Tiles in the current view are never freed, so a view larger than the
+//   budget temporarily goes over it.
+// - The obstacle set is checked only when entities are added or removed
+//   (PoseCache structure version). If any obstacle's pose, size, image,
+//   colour or roundness changed, or an obstacle came or went, every tile is
+//   dropped and rebaked on demand. invalidate() does the same for callers
+//   that change obstacles in place (a level hot-reload).
+//
+// Tiles hold premultiplied colour: baking blends colour as usual but adds
+// alpha (src + dst * (1 - src)), and submit() marks the tiles premultiplied so
+// the frame composites them with BLEND_ALPHA_PREMULTIPLY. Edges then come out
+// as if the obstacles were drawn straight to the screen, without the dark
+// fringe of blending with alpha twice.
+//
+// Main thread only (GL). prepare() switches render targets, so it must run
+// outside BeginMode2D/BeginDrawing; RenderFrame calls it first.
+class StaticTileCache
+{
+public:
+    int tileSize{512};                         // pixels per tile side
+    std::size_t budgetBytes{64u * 1024u * 1024u}; // VRAM kept for baked tiles
+
+    StaticTileCache() = default;
+    StaticTileCache(const StaticTileCache &) = delete;
+    StaticTileCache &operator=(const StaticTileCache &) = delete;
+    ~StaticTileCache() { clear(); }
+
+    // Drop every baked tile and the obstacle bins (needs the GL context)
+    void clear()
+    {
+        for (auto &entry : tiles)
+            UnloadRenderTexture(entry.second.target);
+        tiles.clear();
+        lru.clear();
+        bins.clear();
+        bytes = 0;
+        binned = false;
+    }
+
+    // Rebake everything on next use
+    void invalidate() { clear(); }
+
+    // Find the tiles overlapping `view`, rebinning the obstacles if they
+    // changed and baking the missing tiles
+    void prepare(const ComponentStore &store, Rectangle view, float unitsPerMeter)
+    {
+        const PoseCache &poses = store.pool<BodyPose>();
+        if (version != poses.structureVersion())
+        {
+            version = poses.structureVersion();
+            const uint64_t hash = Signature(store);
+            if (hash != signature)
+            {
+                clear();
+                signature = hash;
+            }
+        }
+        if (!binned)
+            rebin(store);
+
+        ++frame;
+        baked = 0;
+        visible.clear();
+        const int x0 = (int)floorf(view.x / tileSize);
+        const int y0 = (int)floorf(view.y / tileSize);
+        const int x1 = (int)floorf((view.x + view.width) / tileSize);
+        const int y1 = (int)floorf((view.y + view.height) / tileSize);
+        for (int ty = y0; ty <= y1; ++ty)
+        {
+            for (int tx = x0; tx <= x1; ++tx)
+            {
+                const uint64_t key = Key(tx, ty);
+                auto bin = bins.find(key);
+                if (bin == bins.end())
+                    continue; // nothing static here
+                auto it = tiles.find(key);
+                if (it == tiles.end())
+                {
+                    it = tiles.emplace(key, Tile{bake(store, tx, ty, bin->second, unitsPerMeter), lru.end(), 0}).first;
+                    lru.push_front(key);
+                    it->second.position = lru.begin();
+                    bytes += TileBytes();
+                    ++baked;
+                }
+                else
+                    lru.splice(lru.begin(), lru, it->second.position);
+                it->second.lastFrame = frame;
+                visible.push_back({tx, ty, it->second.target.texture});
+            }
+        }
+        evict();
+    }
+
+    // One premultiplied quad per visible tile into the batch's current layer
+    void submit(SpriteBatch &batch) const
+    {
+        const float size = static_cast<float>(tileSize);
+        const float half = 0.5f * size;
+        batch.setPremultiplied(true);
+        for (const Visible &tile : visible)
+        {
+            // Render textures are stored bottom-up: flip the source rectangle
+            batch.box(tile.texture, {0.0f, size, size, -size}, {tile.x * size + half, tile.y * size + half},
+                      {half, half}, 1.0f, 0.0f, WHITE);
+        }
+        batch.setPremultiplied(false);
+    }
+
+    std::size_t tileCount() const { return tiles.size(); }
+    std::size_t visibleCount() const { return visible.size(); }
+    std::size_t bakedLastFrame() const { return baked; }
+    std::size_t usedBytes() const { return bytes; }
+
+private:
+    struct Tile
+    {
+        RenderTexture2D target;
+        std::list<uint64_t>::iterator position; // in lru
+        uint64_t lastFrame;
+    };
+
+    struct Visible
+    {
+        int x, y;
+        Texture texture;
+    };
+
+    std::unordered_map<uint64_t, Tile> tiles;
+    std::list<uint64_t> lru;                                    // most recently drawn first
+    std::unordered_map<uint64_t, std::vector<EntityId>> bins;   // obstacles touching each tile
+    std::vector<Visible> visible;
+    SpriteBatch batch; // bake scratch, separate from the frame's batch
+    std::size_t bytes{0};
+    std::size_t baked{0};
+    uint64_t frame{0};
+    uint64_t signature{0};
+    uint32_t version{0xFFFFFFFFu};
+    bool binned{false};
+
+    static uint64_t Key(int tx, int ty)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(tx)) << 32) | static_cast<uint32_t>(ty);
+    }
+
+    std::size_t TileBytes() const { return static_cast<std::size_t>(tileSize) * tileSize * 4u; }
+
+    // FNV-1a over what an obstacle's render hook reads
+    static uint64_t Signature(const ComponentStore &store)
+    {
+        uint64_t hash = 1469598103934665603ull;
+        auto mix = [&hash](const void *data, std::size_t size)
+        {
+            const unsigned char *bytes = static_cast<const unsigned char *>(data);
+            for (std::size_t i = 0; i < size; ++i)
+                hash = (hash ^ bytes[i]) * 1099511628211ull;
+        };
+        const PoseCache &poses = store.pool<BodyPose>();
+        for (EntityId id : store.pool<ObstacleTag>().entities())
+        {
+            mix(&id, sizeof(id));
+            if (poses.has(id))
+            {
+                const BodyPose pose = poses.interpolated(id);
+                mix(&pose, sizeof(pose));
+            }
+            if (const SpriteTransform *transform = store.tryGet<SpriteTransform>(id))
+                mix(&transform->extent, sizeof(transform->extent));
+            if (const Sprite *sprite = store.tryGet<Sprite>(id))
+            {
+                mix(&sprite->texture.id, sizeof(sprite->texture.id));
+                mix(&sprite->source, sizeof(sprite->source));
+            }
+            if (const VisualStyle *visual = store.tryGet<VisualStyle>(id))
+            {
+                mix(&visual->color, sizeof(visual->color));
+                mix(&visual->roundness, sizeof(visual->roundness));
+            }
+        }
+        return hash;
+    }
+
+    // Each obstacle goes into every tile its bounding circle touches
+    void rebin(const ComponentStore &store)
+    {
+        bins.clear();
+        const PoseCache &poses = store.pool<BodyPose>();
+        for (EntityId id : store.pool<ObstacleTag>().entities())
+        {
+            const SpriteTransform *transform = store.tryGet<SpriteTransform>(id);
+            if (!transform || !poses.has(id) || !store.has<Script>(id))
+                continue;
+            const BodyPose pose = poses.interpolated(id);
+            const float r = sqrtf(transform->extent.x * transform->extent.x + transform->extent.y * transform->extent.y);
+            const int x0 = (int)floorf((pose.x - r) / tileSize);
+            const int y0 = (int)floorf((pose.y - r) / tileSize);
+            const int x1 = (int)floorf((pose.x + r) / tileSize);
+            const int y1 = (int)floorf((pose.y + r) / tileSize);
+            for (int ty = y0; ty <= y1; ++ty)
+            {
+                for (int tx = x0; tx <= x1; ++tx)
+                    bins[Key(tx, ty)].push_back(id);
+            }
+        }
+        binned = true;
+    }
+
+    // Draw the tile's obstacles into a new render texture, the tile's world
+    // origin at its top-left corner
+    RenderTexture2D bake(const ComponentStore &store, int tx, int ty, const std::vector<EntityId> &ids,
+                         float unitsPerMeter)
+    {
+        RenderTexture2D target = LoadRenderTexture(tileSize, tileSize);
+        batch.clear();
+        batch.setLayer(RenderLayer::Obstacles);
+        for (EntityId id : ids)
+        {
+            const Script &script = store.get<Script>(id);
+            if (script.render)
+                script.render(store, id, unitsPerMeter, batch);
+        }
+
+        Camera2D camera = {};
+        camera.target = {static_cast<float>(tx * tileSize), static_cast<float>(ty * tileSize)};
+        camera.zoom = 1.0f;
+        BeginTextureMode(target);
+        ClearBackground(BLANK);
+        BeginMode2D(camera);
+        // Colour blends with alpha, alpha accumulates: the tile ends up premultiplied
+        rlSetBlendFactorsSeparate(RL_SRC_ALPHA, RL_ONE_MINUS_SRC_ALPHA, RL_ONE, RL_ONE_MINUS_SRC_ALPHA, RL_FUNC_ADD,
+                                  RL_FUNC_ADD);
+        BeginBlendMode(BLEND_CUSTOM_SEPARATE);
+        batch.draw();
+        EndBlendMode();
+        EndMode2D();
+        EndTextureMode();
+        return target;
+    }
+
+    // Free least recently drawn tiles over the budget, never this frame's
+    void evict()
+    {
+        while (bytes > budgetBytes && !lru.empty())
+        {
+            auto it = tiles.find(lru.back());
+            if (it->second.lastFrame == frame)
+                break;
+            UnloadRenderTexture(it->second.target);
+            lru.pop_back();
+            tiles.erase(it);
+            bytes -= TileBytes();
+        }
+    }
+};
@@ -10,15 +10,31 @@
 #include "includes/entities/factory.hpp"
 #include "includes/systems/render_system.hpp"
 #include "includes/systems/logic_system.hpp"
+#include "includes/systems/lifetime_system.hpp"
+#include "includes/systems/chain_lod_system.hpp"
 #include "includes/systems/advertisement_system.hpp"
 #include "includes/systems/camera_system.hpp"
+#include "includes/systems/input_system.hpp"
+#include "includes/systems/sdf_shapes.hpp"
 #include "includes/core/entity_manager.hpp"
+#include "includes/core/component_store.hpp"
+#include "includes/core/pose_cache.hpp"
+#include "includes/core/command_buffer.hpp"
+#include "includes/core/job_system.hpp"
+#include "includes/core/system_scheduler.hpp"
+#include "includes/core/physics_tasks.hpp"
+#include "includes/core/fixed_timestep.hpp"
 #include "includes/core/world_loader.hpp"
+#include "includes/core/world_snapshot.hpp"
+#include "includes/core/input_trace.hpp"
+#include "includes/core/texture_atlas.hpp"
 
 #include <assert.h>
+#include <algorithm>
 #include <vector>
 #include <cmath>
 #include <cstdio>
+#include <cstdlib>
 #include <map>
 #include <string>
 
@@ -29,13 +45,17 @@
 #define ASSET_PATH(path) (path)
 #endif
 
-// Simple texture cache to avoid loading same texture multiple times
+// Simple texture cache to avoid loading same texture multiple times.
+// Images packed in the atlas resolve to their atlas region instead.
 struct TextureCache
 {
     std::map<std::string, Texture> textures;
+    const TextureAtlas *atlas{nullptr};
 
-    Texture load(const std::string &path)
+    Sprite load(const std::string &path)
     {
+        if (const Sprite *region = atlas ? atlas->find(path) : nullptr)
+            return *region;
         auto it = textures.find(path);
         if (it != textures.end())
         {
@@ -57,8 +77,6 @@ struct TextureCache
     }
 };
 
-// GameEntity is declared in includes/entities/types.hpp
-
 int main(void)
 {
     int width = 1920, height = 1080;
@@ -69,16 +87,32 @@ int main(void)
     float lengthUnitsPerMeter = 20.0f;
     b2SetLengthUnitsPerMeter(lengthUnitsPerMeter);
 
+    // Worker threads shared by the scheduler and Box2D's solver.
+    // IMPALE_WORKERS overrides the default (one per extra hardware thread; 0 = single-threaded)
+    unsigned workerCount = JobSystem::DefaultWorkerCount();
+    if (const char *env = std::getenv("IMPALE_WORKERS"))
+        workerCount = static_cast<unsigned>(std::strtoul(env, nullptr, 10));
+    JobSystem jobs{workerCount};
+    PhysicsTasks physicsTasks{jobs};
+
     b2WorldDef worldDef = b2DefaultWorldDef();
 
     worldDef.gravity.y = 1.8f * lengthUnitsPerMeter;
+    physicsTasks.configure(worldDef); // workerCount/enqueueTask/finishTask
     b2WorldId worldId = b2CreateWorld(&worldDef);
 
+    // Atlas pages built by the-impale-atlas (optional: without them every image loads on its own)
+    TextureAtlas atlas;
+    if (atlas.load(ASSET_PATH("atlas/atlas.toml")))
+        TraceLog(LOG_INFO, "Texture atlas: %zu images on %zu pages", atlas.regionCount(), atlas.pageCount());
+
     // Create texture cache
     TextureCache textureCache;
+    textureCache.atlas = &atlas;
 
     // Initialize advertisement system
     AdvertisementSystem adSystem;
+    adSystem.SetAtlas(&atlas);
     if (!adSystem.LoadFromTOML(ASSET_PATH("ads_config.toml")))
     {
         TraceLog(LOG_WARNING, "Failed to load ads configuration, continuing without ads");
@@ -92,9 +126,11 @@ int main(void)
         TraceLog(LOG_INFO, "Advertisement system initialized");
     }
 
-    // Initialize game camera for parallax ads
+    // Game camera: the world (level and world/parallax ads) is drawn through it.
+    // Centred on the screen centre, so level pixels start where they are authored
+    // (ad world positions in ads_config.toml are authored for this start too).
     GameCamera gameCamera;
-    gameCamera.position = {0.0f, 0.0f};
+    gameCamera.position = {(float)width / 2.0f, (float)height / 2.0f};
     gameCamera.offset = {(float)width / 2.0f, (float)height / 2.0f};
     gameCamera.zoom = 1.0f;
     gameCamera.rotation = 0.0f;
@@ -107,29 +143,24 @@ int main(void)
     adSystem.ActivateAd("parallax_bg_template");
     adSystem.ActivateAd("world_sign_001");
 
-    Texture groundTexture = textureCache.load(ASSET_PATH("ground.png"));
-    Texture boxTexture = textureCache.load(ASSET_PATH("block.png"));
+    Sprite groundSprite = textureCache.load(ASSET_PATH("ground.png"));
+    Sprite boxSprite = textureCache.load(ASSET_PATH("block.png"));
 
-    b2Vec2 groundExtent = {0.5f * groundTexture.width, 0.5f * groundTexture.height};
-    b2Vec2 boxExtent = {0.5f * boxTexture.width, 0.5f * boxTexture.height};
+    b2Vec2 groundExtent = {0.5f * groundSprite.width(), 0.5f * groundSprite.height()};
+    b2Vec2 boxExtent = {0.5f * boxSprite.width(), 0.5f * boxSprite.height()};
 
     b2Polygon groundPolygon = b2MakeBox(groundExtent.x / lengthUnitsPerMeter, groundExtent.y / lengthUnitsPerMeter);
     b2Polygon boxPolygon = b2MakeBox(boxExtent.x / lengthUnitsPerMeter, boxExtent.y / lengthUnitsPerMeter);
 
     EntityManager entityManager;
-
-    std::vector<GameEntity> boxEntities;
-    std::vector<GameEntity> obstacleEntities;
-    std::vector<GameEntity> spikeEntities;
-    std::vector<GameEntity> throwerEntities;
+    ComponentStore store{entityManager};
+    store.pool<BodyPose>().setUnitsPerMeter(lengthUnitsPerMeter);
 
     // Load scenario from TOML with texture loader
-    std::vector<GameEntity> dummyGrounds; // not used, kept for API compat
-    level::BuildContext ctx{entityManager, worldId, lengthUnitsPerMeter,
-                            groundTexture, boxTexture,
+    level::BuildContext ctx{store, worldId, lengthUnitsPerMeter,
+                            groundSprite, boxSprite,
                             groundPolygon, boxPolygon,
                             groundExtent, boxExtent,
-                            dummyGrounds, boxEntities, obstacleEntities, spikeEntities, throwerEntities,
                             [&textureCache](const std::string &path)
                             {
 #ifdef __EMSCRIPTEN__
@@ -144,7 +175,36 @@ int main(void)
                                 return textureCache.load(path);
 #endif
                             }};
-    level::LoadScenarioFromToml(ASSET_PATH("levels/demo.toml"), ctx);
+    // Input traces: IMPALE_RECORD=<file> records every tick's input (saved on
+    // exit), IMPALE_REPLAY=<file> plays one back instead of live input and
+    // quits when it ends. A replay loads the trace's level at the trace's rate.
+    InputTrace trace;
+    const char *recordPath = std::getenv("IMPALE_RECORD");
+    const char *replayPath = std::getenv("IMPALE_REPLAY");
+    const bool replaying = replayPath && trace.load(replayPath);
+    if (replayPath && !replaying)
+        TraceLog(LOG_WARNING, "Cannot read input trace %s, playing live", replayPath);
+    const bool recording = recordPath && !replaying;
+
+    const std::string levelPath = replaying ? trace.level : std::string(ASSET_PATH("levels/demo.toml"));
+    level::LoadScenarioFromToml(levelPath, ctx);
+
+    // Structural changes (spawns, despawns, joints) recorded by systems, applied once per frame
+    CommandBuffer commands;
+
+    // Projectile despawn rules: leave the level area, get old, exceed the cap, or settle on a spike
+    LifetimeContext lifetimeCtx{store, commands, DespawnRules{}, {}};
+    lifetimeCtx.rules.bounds = {-500.0f, -2000.0f, (float)width + 1000.0f, (float)height + 2500.0f};
+
+    // Settled or over-budget impaled boxes merge into their spike's body
+    ConsolidationContext consolidationCtx{store, commands};
+
+    // Pre-create one disabled body per allowed live projectile so throws never allocate
+    // (plus headroom: the count cap is enforced one frame after a spawn is flushed)
+    const std::size_t projectileCapacity = lifetimeCtx.rules.maxCount + 8;
+    BodyPool projectilePool;
+    projectilePool.build(worldId, boxPolygon, ProjectileMaterial(), projectileCapacity);
+    reserveProjectiles(store, projectileCapacity);
 
     bool pause = false;
     bool showDebugWireframe = true; // toggle with 'D' key
@@ -155,99 +215,315 @@ int main(void)
     // Create logic context
     LogicContext logicCtx{
         worldId, lengthUnitsPerMeter,
-        boxEntities, obstacleEntities, spikeEntities, throwerEntities,
-        entityManager,
-        boxTexture, boxPolygon, boxExtent,
+        store,
+        projectilePool,
+        commands,
+        boxSprite, boxPolygon, boxExtent,
         pause};
 
-    // Create render context
+    // Create render context; the sprite batch is reused frame to frame.
+    // Culling (the spatial grid) is attached once the grid exists below.
+    SpriteBatch spriteBatch;
+    Shader sdfShader = LoadSdfShapeShader(); // saws, hooks, untextured spikes
+    spriteBatch.setSdfShader(sdfShader);
+    if (!spriteBatch.hasSdf())
+        TraceLog(LOG_WARNING, "SDF shape shader unavailable, spikes are drawn from plain quads");
+    RenderCulling renderCulling;
+    StaticTileCache staticTiles; // obstacles baked into 512 px tiles, 64 MB of VRAM at most
     RenderContext renderCtx{
         width, height, lengthUnitsPerMeter,
-        boxEntities, obstacleEntities, spikeEntities, throwerEntities,
-        showDebugWireframe, &debugRope};
-
-    while (!WindowShouldClose())
+        store,
+        showDebugWireframe, &debugRope,
+        spriteBatch, &gameCamera, &renderCulling, &staticTiles};
+
+    // Pools must exist before systems run concurrently (pool<T>() creates lazily)
+    registerGamePools(store);
+
+    bool autoScroll = false;  // auto-scroll da câmera (movimento automático horizontal; move o nível junto)
+    float scrollSpeed = 50.0f; // pixels por segundo
+    int cleanupFrameCounter = 0;
+
+    // Fixed simulation rate, independent of the render rate.
+    // IMPALE_SIM_HZ, IMPALE_SUBSTEPS and IMPALE_MAX_STEPS override the defaults
+    FixedStepConfig stepConfig;
+    if (const char *env = std::getenv("IMPALE_SIM_HZ"))
+        stepConfig.hz = std::strtof(env, nullptr);
+    if (const char *env = std::getenv("IMPALE_SUBSTEPS"))
+        stepConfig.subSteps = std::atoi(env);
+    if (const char *env = std::getenv("IMPALE_MAX_STEPS"))
+        stepConfig.maxStepsPerFrame = std::atoi(env);
+    if (replaying)
+    {
+        stepConfig.hz = trace.hz;
+        stepConfig.subSteps = trace.subSteps;
+        TraceLog(LOG_INFO, "Replaying %s: %zu ticks of %s", replayPath, trace.size(), trace.level.c_str());
+    }
+    FixedTimestep clock{stepConfig};
+    logicCtx.subSteps = clock.config().subSteps;
+    TraceLog(LOG_INFO, "Simulation: %.0f Hz, %d sub-steps, up to %d ticks per frame",
+             clock.config().hz, clock.config().subSteps, clock.config().maxStepsPerFrame);
+
+    // Systems with the components/resources they touch. Systems without
+    // conflicts run in parallel (e.g. saw spin alongside the capture check);
+    // anything polling raylib stays on the main thread.
+    // `simulation` runs once per fixed tick, `frame` once per rendered frame.
+    logicCtx.jobs = &jobs;
+    SpatialGrid spatialGrid{64.0f}; // pixels per cell, about two box widths
+    logicCtx.grid = &spatialGrid;
+    renderCulling.grid = &spatialGrid;
+    SystemScheduler simulation{jobs};
+    SystemScheduler frame{jobs};
+    using Affinity = SystemScheduler::Affinity;
+
+    // Input: polled once per frame, consumed by the next tick (see TickInput)
+    InputSampler input;
+    frame.add("input", SystemAccess().writes<InputSampler>(),
+              [&](float)
+              {
+                  if (!replaying)
+                      input.poll();
+              },
+              Affinity::MainThread);
+
+    simulation.add("physics", SystemAccess().reads<MergedShape>().writes<b2WorldId, BodyPose, SpatialGrid>(),
+                   [&](float dt)
+                   { StepPhysics(logicCtx, dt); });
+
+    simulation.add("capture",
+                   SystemAccess()
+                       .reads<b2WorldId, SpikeProperties, ChainHook, PhysicsBody, SpriteTransform, BodyPose, CaptureZone, SpatialGrid>()
+                       .writes<Impaled, ImpaleCluster, CommandBuffer>(),
+                   [&](float)
+                   { UpdateCapture(logicCtx); });
+
+    simulation.add("consolidate",
+                   SystemAccess()
+                       .reads<BodyPose, Impaled, MergedShape, SpikeProperties, ChainHook>()
+                       .writes<ImpaleCluster, CommandBuffer>(),
+                   [&](float)
+                   {
+                       if (!pause)
+                           UpdateConsolidation(consolidationCtx);
+                   });
+
+    simulation.add("scripts",
+                   SystemAccess().reads<Script, SpikeProperties>().writes<SawRotation, ThrowerContext>(),
+                   [&](float dt)
+                   { UpdateScripts(logicCtx, dt); });
+
+    simulation.add("lifetime",
+                   SystemAccess()
+                       .reads<BodyPose, Impaled>()
+                       .writes<Lifetime, CommandBuffer>(),
+                   [&](float dt)
+                   {
+                       if (!pause)
+                           UpdateLifetime(lifetimeCtx, dt);
+                   });
+
+    // Ad animation and display timers advance with simulated time; only touches
+    // the ads, so it runs alongside physics and the capture check
+    simulation.add("ads", SystemAccess().writes<AdvertisementSystem>(),
+                   [&](float dt)
+                   { adSystem.Update(dt); });
+
+    // Single sync point after the physics step: apply recorded spawns/despawns/joints
+    simulation.add("flush", SystemAccess().exclusive(),
+                   [&](float)
+                   { commands.flush(store, worldId); });
+
+    // Chain spikes swap rope <-> links after the flush (creates/destroys bodies)
+    ChainLodContext chainLodCtx{store, worldId, lengthUnitsPerMeter};
+    chainLodCtx.grid = &spatialGrid;
+    chainLodCtx.view = gameCamera.ViewBounds(); // then each tick's camera (applyInput)
+    simulation.add("chain-lod", SystemAccess().exclusive(),
+                   [&](float dt)
+                   {
+                       if (!pause)
+                           UpdateChainLod(chainLodCtx, dt);
+                   });
+
+    // Limpa anúncios que estão muito longe da câmera (economiza memória)
+    // Executado a cada 60 frames (~1 segundo a 60 fps)
+    frame.add("ads-cleanup", SystemAccess().reads<GameCamera>().writes<AdvertisementSystem>(),
+              [&](float)
+              {
+                  if (++cleanupFrameCounter >= 60)
+                  {
+                      adSystem.CleanupOffscreenAds(gameCamera, 3000.0f); // Remove ads > 3000px de distância
+                      cleanupFrameCounter = 0;
+                  }
+              },
+              Affinity::MainThread);
+
+    frame.add("camera", SystemAccess().writes<GameCamera>(),
+              [&](float dt)
+              {
+                  if (replaying)
+                      return; // the trace sets the camera every tick
+
+                  if (IsKeyPressed(KEY_A))
+                  {
+                      autoScroll = !autoScroll;
+                      TraceLog(LOG_INFO, "Auto-scroll: %s", autoScroll ? "ON" : "OFF");
+                  }
+
+                  if (autoScroll)
+                  {
+                      gameCamera.position.x += scrollSpeed * dt;
+                  }
+
+                  // Controles manuais (desativa auto-scroll ao usar)
+                  float cameraSpeed = 300.0f * dt;
+                  if (IsKeyDown(KEY_LEFT))
+                  {
+                      gameCamera.position.x -= cameraSpeed;
+                      autoScroll = false;
+                  }
+                  if (IsKeyDown(KEY_RIGHT))
+                  {
+                      gameCamera.position.x += cameraSpeed;
+                      autoScroll = false;
+                  }
+                  if (IsKeyDown(KEY_UP))
+                      gameCamera.position.y -= cameraSpeed;
+                  if (IsKeyDown(KEY_DOWN))
+                      gameCamera.position.y += cameraSpeed;
+
+                  // Mouse drag (middle button) - desativa auto-scroll
+                  if (IsMouseButtonDown(MOUSE_MIDDLE_BUTTON))
+                  {
+                      Vector2 delta = GetMouseDelta();
+                      gameCamera.position.x -= delta.x / gameCamera.zoom;
+                      gameCamera.position.y -= delta.y / gameCamera.zoom;
+                      autoScroll = false;
+                  }
+              },
+              Affinity::MainThread);
+
+    simulation.build();
+    frame.build();
+
+    // Level start for instant resets (R) and a quick save slot (F5 save, F9 load)
+    WorldSnapshot levelStart;
+    WorldSnapshot quickSave;
+    levelStart.capture(store);
+    auto restoreWorld = [&](const WorldSnapshot &snapshot, const char *name)
+    {
+        const double start = GetTime();
+        commands.clear(); // input recorded for a tick that will not run
+        if (snapshot.restore(store, worldId, lengthUnitsPerMeter))
+            TraceLog(LOG_INFO, "Restored %s (%zu bodies) in %.3f ms", name, snapshot.bodyCount(),
+                     1000.0 * (GetTime() - start));
+        else
+            TraceLog(LOG_WARNING, "Cannot restore %s", name);
+    };
+
+    // Player input of one tick, applied before its simulation systems run
+    auto applyInput = [&](const TickInput &tick)
     {
-        if (IsKeyPressed(KEY_P))
+        chainLodCtx.view = tick.view({(float)width, (float)height});
+
+        if (tick.has(TickInput::TogglePause))
         {
             pause = !pause;
             logicCtx.isPaused = pause;
         }
 
-        if (IsKeyPressed(KEY_D))
+        if (tick.has(TickInput::ToggleDebug))
         {
             showDebugWireframe = !showDebugWireframe;
             renderCtx.showDebugWireframe = showDebugWireframe;
         }
 
-        // Update game logic
-        UpdateLogic(logicCtx, GetFrameTime());
-
-        // Update advertisement system
-        adSystem.Update(GetFrameTime());
-
-        // Limpa anúncios que estão muito longe da câmera (economiza memória)
-        // Executado a cada 60 frames (~1 segundo a 60 fps)
-        static int cleanupFrameCounter = 0;
-        if (++cleanupFrameCounter >= 60)
+        if (tick.has(TickInput::ToggleChainLod))
         {
-            adSystem.CleanupOffscreenAds(gameCamera, 3000.0f); // Remove ads > 3000px de distância
-            cleanupFrameCounter = 0;
+            chainLodCtx.enabled = !chainLodCtx.enabled;
+            TraceLog(LOG_INFO, "Chain LOD: %s", chainLodCtx.enabled ? "ON" : "OFF (all chains expanded)");
         }
 
-        // Auto-scroll da câmera (movimento automático horizontal)
-        static bool autoScroll = true;
-        static float scrollSpeed = 50.0f; // pixels por segundo
-
-        if (IsKeyPressed(KEY_A))
+        if (tick.has(TickInput::ToggleConsolidation))
         {
-            autoScroll = !autoScroll;
-            TraceLog(LOG_INFO, "Auto-scroll: %s", autoScroll ? "ON" : "OFF");
+            consolidationCtx.enabled = !consolidationCtx.enabled;
+            TraceLog(LOG_INFO, "Impaled stack consolidation: %s", consolidationCtx.enabled ? "ON" : "OFF");
         }
 
-        if (autoScroll)
+        if (tick.has(TickInput::Reset))
+            restoreWorld(levelStart, "level start");
+        if (tick.has(TickInput::QuickSave))
         {
-            gameCamera.position.x += scrollSpeed * GetFrameTime();
+            quickSave.capture(store);
+            TraceLog(LOG_INFO, "Quick save (%zu bodies)", quickSave.bodyCount());
         }
+        if (tick.has(TickInput::QuickLoad))
+            restoreWorld(quickSave, "quick save");
 
-        // Controles manuais (desativa auto-scroll ao usar)
-        float cameraSpeed = 300.0f * GetFrameTime();
-        if (IsKeyDown(KEY_LEFT))
-        {
-            gameCamera.position.x -= cameraSpeed;
-            autoScroll = false;
-        }
-        if (IsKeyDown(KEY_RIGHT))
-        {
-            gameCamera.position.x += cameraSpeed;
-            autoScroll = false;
-        }
-        if (IsKeyDown(KEY_UP))
-            gameCamera.position.y -= cameraSpeed;
-        if (IsKeyDown(KEY_DOWN))
-            gameCamera.position.y += cameraSpeed;
+        // Replays do not open ad links again
+        if (tick.pressed() && !replaying)
+            adSystem.CheckClick(tick.press);
+
+        UpdateThrower(logicCtx, tick);
+    };
+
+    std::size_t replayTick = 0;
+    std::size_t divergedAt = 0; // first tick whose checksum differs from the recording (0 = none)
+    float worstFrame = 0.0f;
+    bool running = true;
 
-        // Mouse drag (middle button) - desativa auto-scroll
-        if (IsMouseButtonDown(MOUSE_MIDDLE_BUTTON))
+    while (running && !WindowShouldClose())
+    {
+        // Per-worker job utilization since the last press
+        if (IsKeyPressed(KEY_J))
         {
-            Vector2 delta = GetMouseDelta();
-            gameCamera.position.x -= delta.x / gameCamera.zoom;
-            gameCamera.position.y -= delta.y / gameCamera.zoom;
-            autoScroll = false;
+            jobs.logUtilization();
+            jobs.resetStats();
         }
 
-        // Check ad clicks
-        if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON))
+        // Update: input, ad cleanup and camera once per frame, then as many fixed
+        // simulation ticks (tick input, physics, capture, consolidate, scripts, lifetime, ads, flush, chain LOD)
+        // as the accumulated frame time covers
+        const float frameTime = GetFrameTime();
+        worstFrame = std::max(worstFrame, frameTime);
+        frame.run(frameTime);
+        const int ticks = clock.advance(frameTime);
+        for (int i = 0; i < ticks; ++i)
         {
-            Vector2 mousePos = GetMousePosition();
-            adSystem.CheckClick(mousePos);
+            TickInput tick;
+            if (replaying)
+            {
+                if (replayTick >= trace.size())
+                {
+                    running = false;
+                    break;
+                }
+                tick = trace.at(replayTick);
+                gameCamera.position = tick.camera;
+            }
+            else
+                tick = input.take(gameCamera);
+
+            applyInput(tick);
+            simulation.run(clock.dt());
+
+            if (recording)
+            {
+                trace.record(tick);
+                trace.recordResult(store);
+            }
+            if (replaying && !trace.verify(++replayTick, store) && divergedAt == 0)
+            {
+                divergedAt = replayTick;
+                TraceLog(LOG_WARNING, "Replay diverged from the recording by tick %zu", divergedAt);
+            }
         }
 
-        // Render frame
-        RenderFrame(renderCtx);
+        // Render frame: poses blended between the last two ticks
+        store.pool<BodyPose>().setInterpolation(clock.alpha());
+        spriteBatch.clear();
 
-        // Render advertisements with parallax/world-space (must be before fixed screen ads)
-        adSystem.RenderWithCamera(gameCamera);
+        // Parallax/world-space advertisements join the entity batch, over the level
+        adSystem.SubmitWithCamera(gameCamera, spriteBatch);
+        RenderFrame(renderCtx);
 
         // Render fixed screen advertisements on top
         adSystem.Render();
@@ -257,11 +533,32 @@ int main(void)
                             gameCamera.position.x, gameCamera.position.y,
                             autoScroll ? "ON" : "OFF"),
                  10, height - 30, 20, YELLOW);
+        EndDrawing();
+    }
+
+    if (replaying)
+        TraceLog(LOG_INFO, "Replay %s: %zu of %zu ticks, %s, worst frame %.2f ms", replayPath, replayTick,
+                 trace.size(), divergedAt ? "diverged" : "checksums match", 1000.0f * worstFrame);
+    if (recording)
+    {
+        trace.level = levelPath;
+        trace.hz = clock.config().hz;
+        trace.subSteps = clock.config().subSteps;
+        if (trace.save(recordPath))
+            TraceLog(LOG_INFO, "Input trace: %zu ticks written to %s", trace.size(), recordPath);
+        else
+            TraceLog(LOG_WARNING, "Cannot write input trace %s", recordPath);
     }
 
-    // Cleanup
+    // Cleanup: component pools (script contexts included) are dropped in bulk,
+    // destroying the world releases every body and joint at once
+    store.clear();
+    b2DestroyWorld(worldId);
     adSystem.Cleanup();
     textureCache.unloadAll();
+    staticTiles.clear();
+    atlas.unload();
+    UnloadShader(sdfShader);
     CloseWindow();
 
     return 0;
@@ -0,0 +1,116 @@
+// Atlas packer: packs the game's small images into a few atlas pages.
+//
+// Every PNG under the asset root (level textures, ad creatives) that fits in
+// --max-image pixels is packed into OUT/atlas_N.png, and OUT/atlas.toml maps
+// each one's path relative to the root ("box.png", "ads/banner_top.png") to
+// its page and rectangle. The game loads the manifest at startup
+// (TextureAtlas) and resolves the same paths through it, so level and ad
+// configs keep naming the source images. Run it before building the game;
+// the output is copied with the other assets.
+//
+// Usage: the-impale-atlas [options] [ROOT [OUT]]   (default: src/assets src/assets/atlas)
+
+#include "raylib.h"
+
+#include "../includes/core/texture_atlas.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::fprintf(stderr,
+                     "Usage: the-impale-atlas [options] [ROOT [OUT]]\n"
+                     "  --page N        maximum page size in pixels (default 2048)\n"
+                     "  --padding N     edge padding around each image (default 2)\n"
+                     "  --max-image N   larger images stay separate textures (default 512)\n"
+                     "  ROOT            asset directory to scan for PNGs (default src/assets)\n"
+                     "  OUT             output directory (default ROOT/atlas)\n");
+    }
+
+    // PNGs under root, relative to it and sorted so the output is reproducible;
+    // the output directory itself is skipped
+    std::vector<std::string> FindImages(const std::filesystem::path &root, const std::filesystem::path &out)
+    {
+        namespace fs = std::filesystem;
+        std::vector<std::string> images;
+        const fs::path skip = fs::weakly_canonical(out);
+        for (auto it = fs::recursive_directory_iterator(root); it != fs::recursive_directory_iterator(); ++it)
+        {
+            if (it->is_directory() && fs::weakly_canonical(it->path()) == skip)
+            {
+                it.disable_recursion_pending();
+                continue;
+            }
+            if (it->is_regular_file() && it->path().extension() == ".png")
+                images.push_back(it->path().lexically_relative(root).generic_string());
+        }
+        std::sort(images.begin(), images.end());
+        return images;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    AtlasBuildOptions options;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i)
+    {
+        const char *arg = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        int *target = std::strcmp(arg, "--page") == 0        ? &options.pageSize
+                      : std::strcmp(arg, "--padding") == 0   ? &options.padding
+                      : std::strcmp(arg, "--max-image") == 0 ? &options.maxImageSize
+                                                             : nullptr;
+        if (target)
+        {
+            if (!value)
+            {
+                std::fprintf(stderr, "%s needs a value\n", arg);
+                return 2;
+            }
+            *target = std::atoi(value);
+            ++i;
+        }
+        else if (arg[0] == '-')
+        {
+            PrintUsage();
+            return 2;
+        }
+        else
+            paths.push_back(arg);
+    }
+    if (paths.size() > 2 || options.pageSize <= 0 || options.padding < 0)
+    {
+        PrintUsage();
+        return 2;
+    }
+    SetTraceLogLevel(LOG_WARNING);
+
+    const std::string root = paths.size() > 0 ? paths[0] : "src/assets";
+    const std::string out = paths.size() > 1 ? paths[1] : root + "/atlas";
+    std::error_code error;
+    std::filesystem::create_directories(out, error);
+    if (error || !std::filesystem::is_directory(root))
+    {
+        std::fprintf(stderr, "Cannot use %s -> %s\n", root.c_str(), out.c_str());
+        return 1;
+    }
+
+    const std::vector<std::string> images = FindImages(root, out);
+    const int packed = BuildAtlas(root, images, out, options);
+    if (packed < 0)
+    {
+        std::fprintf(stderr, "Cannot write the atlas to %s\n", out.c_str());
+        return 1;
+    }
+    std::printf("Packed %d of %zu images into %s/atlas.toml\n", packed, images.size(), out.c_str());
+    return 0;
+}
@@ -18,7 +18,7 @@ target("the-impale-game")
     add_configfiles("src/assets/**", { onlycopy = true, prefixdir = "" })
     add_configfiles("src/assets/levels/**", { onlycopy = true, prefixdir = "levels" })
     add_configfiles("src/assets/ads/**", { onlycopy = true, prefixdir = "ads" })
-    add_files("src/**.cpp")
+    add_files("src/**.cpp|headless/*.cpp|tools/*.cpp")
     add_packages("raylib", "raygui", "box2d", "toml11")
     -- on_run(function(target)
     --     os.exec("hyprctl dispatch workspace 3")
@@ -37,6 +37,30 @@ target("the-impale-game")
     -- end)
 target_end()
 
+-- Headless batch simulation (no window/GL): many independent worlds across cores
+-- Usage: xmake run the-impale-batch --runs 1000 --power 150:350 levels/demo.toml
+if not is_plat("wasm") then
+target("the-impale-batch")
+    set_kind("binary")
+    set_configdir("$(builddir)/$(plat)/$(arch)/$(mode)")
+    add_configfiles("src/assets/*.png", { onlycopy = true, prefixdir = "" })
+    add_configfiles("src/assets/levels/**", { onlycopy = true, prefixdir = "levels" })
+    add_files("src/headless/*.cpp", "src/core/*.cpp")
+    add_packages("raylib", "box2d", "toml11")
+    set_rundir("$(builddir)/$(plat)/$(arch)/$(mode)")
+target_end()
+
+-- Atlas packer (offline): packs src/assets PNGs into src/assets/atlas, which the
+-- game and web targets then copy with the other assets
+-- Usage: xmake run the-impale-atlas [--page 2048] [--padding 2] [--max-image 512]
+target("the-impale-atlas")
+    set_kind("binary")
+    add_files("src/tools/atlas_main.cpp", "src/core/texture_atlas.cpp")
+    add_packages("raylib", "toml11")
+    set_rundir("$(projectdir)")
+target_end()
+end
+
 -- Web build target (Emscripten/WASM)
 target("the-impale-game-web")
     set_kind("binary")
@@ -52,7 +76,7 @@ target("the-impale-game-web")
     set_extension(".html")
     
     -- Source files and assets
-    add_files("src/**.cpp")
+    add_files("src/**.cpp|headless/*.cpp|tools/*.cpp")
     add_configfiles("src/assets/**", { onlycopy = true, prefixdir = "assets" })
     add_configfiles("src/assets/levels/**", { onlycopy = true, prefixdir = "assets/levels" })
     add_configfiles("src/assets/ads/**", { onlycopy = true, prefixdir = "assets/ads" })